@@ -22,37 +22,78 @@
 #include <fileformats/cadscenefile.h>
 
 #include "config.h"
+#include "nvmeshlet_lod.hpp"
 #include "nvmeshlet_packbasic.hpp"
+#include <nvh/filemapping.hpp>
 #include <nvh/geometry.hpp>
 #include <nvh/misc.hpp>
 
 #include <algorithm>
 #include <cassert>
+#include <cfloat>
+#include <chrono>
 #include <platform.h>
+#include <random>
+
+// hardware float to half conversion, compiled on x86 independent of the target flags
+// and only used when the cpu supports it, see hasF16C
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CADSCENE_F16C 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define CADSCENE_F16C_TARGET
+#else
+#include <cpuid.h>
+#define CADSCENE_F16C_TARGET __attribute__((target("avx,f16c")))
+#endif
+#else
+#define CADSCENE_F16C 0
+#endif
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
+// round to nearest even, denormals, overflow to infinity and NaN payloads
+// match the hardware conversion (F16C), so both paths are bit-identical
 NV_INLINE half floatToHalf(float fval)
 {
-  unsigned long ival = *(unsigned long*)(&fval);
-  if(!ival)
+  uint32_t ival;
+  memcpy(&ival, &fval, sizeof(ival));
+
+  uint32_t sign = (ival >> 16) & 0x8000;
+  ival &= 0x7fffffff;
+
+  if(ival > 0x7f800000)
   {
-    return 0;
+    // NaN, keep quiet
+    return half(sign | 0x7e00 | ((ival >> 13) & 0x03ff));
+  }
+  else if(ival >= 0x47800000)
+  {
+    // >= 65536 and infinity, smaller values that round up overflow below
+    return half(sign | 0x7c00);
+  }
+  else if(ival < 0x38800000)
+  {
+    // denormal or zero, let the float addition do the rounding,
+    // the magic number's exponent places the half's lowest denormal bit at the float's lowest mantissa bit
+    const uint32_t magicBits = 126 << 23;
+    float          magic;
+    memcpy(&magic, &magicBits, sizeof(magic));
+    float sum = fval < 0 ? magic - fval : magic + fval;
+    uint32_t sumBits;
+    memcpy(&sumBits, &sum, sizeof(sumBits));
+    return half(sign | (sumBits - magicBits));
   }
   else
   {
-    unsigned long e = ((ival & 0x7f800000) >> 23) - 127 + 15;
-    if(e < 0)
-    {
-      return 0;
-    }
-    else if(e > 31)
-    {
-      e = 31;
-    }
-    {
-      unsigned long s = ival & 0x80000000;
-      unsigned long f = ival & 0x007fffff;
-      return (half)(((s >> 16) & 0x8000) | ((e << 10) & 0x7c00) | ((f >> 13) & 0x03ff));
-    }
+    // rebias exponent, round mantissa to nearest even
+    uint32_t mantissaOdd = (ival >> 13) & 1;
+    ival += ((15u - 127u) << 23) + 0xfff + mantissaOdd;
+    return half(sign | (ival >> 13));
   }
 }
 
@@ -71,6 +112,70 @@ NV_INLINE void floatToHalfVector(half output[4], const nvmath::vec4f& input)
   output[3] = floatToHalf(input[3]);
 }
 
+static bool hasF16C()
+{
+#if CADSCENE_F16C
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 1);
+  bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+  return avx && (info[2] & (1 << 29));
+#else
+  unsigned int eax, ebx, ecx, edx;
+  return __builtin_cpu_supports("avx") && __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_F16C);
+#endif
+#else
+  return false;
+#endif
+}
+
+static bool useF16C()
+{
+  static const bool supported = hasF16C();
+  return supported;
+}
+
+#if CADSCENE_F16C
+// converts two vectors at once, returns the number of vectors converted,
+// each load reads one float past the vector, so the last vector is left to the caller
+CADSCENE_F16C_TARGET static size_t floatToHalfVectorsF16C(half* output, size_t outputStride, const float* input, size_t count, float w)
+{
+  size_t       i    = 0;
+  const __m128 wVec = _mm_set1_ps(w);
+  for(; i + 2 < count; i += 2)
+  {
+    __m128  v0     = _mm_blend_ps(_mm_loadu_ps(input + i * 3 + 0), wVec, 0x8);
+    __m128  v1     = _mm_blend_ps(_mm_loadu_ps(input + i * 3 + 3), wVec, 0x8);
+    __m128i halves = _mm256_cvtps_ph(_mm256_insertf128_ps(_mm256_castps128_ps256(v0), v1, 1), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storel_epi64((__m128i*)(output + (i + 0) * outputStride), halves);
+    _mm_storeh_pd((double*)(output + (i + 1) * outputStride), _mm_castsi128_pd(halves));
+  }
+  return i;
+}
+#endif
+
+// converts "count" float vec3 to half vec4 with constant w, "outputStride" is in halves,
+// F16C converts pairs of vectors if available, the scalar floatToHalf handles the rest
+static void floatToHalfVectors(half* output, size_t outputStride, const float* input, size_t count, float w)
+{
+  size_t i = 0;
+#if CADSCENE_F16C
+  if(useF16C())
+  {
+    i = floatToHalfVectorsF16C(output, outputStride, input, count, w);
+  }
+#endif
+  half wHalf = floatToHalf(w);
+  for(; i < count; i++)
+  {
+    half* out = output + i * outputStride;
+    out[0]    = floatToHalf(input[i * 3 + 0]);
+    out[1]    = floatToHalf(input[i * 3 + 1]);
+    out[2]    = floatToHalf(input[i * 3 + 2]);
+    out[3]    = wHalf;
+  }
+}
+
 nvmath::vec4f randomVector(float from, float to)
 {
   nvmath::vec4f vec;
@@ -88,6 +193,421 @@ static void storeData(std::vector<uint32_t>& container, size_t size, const void*
   memcpy(container.data(), data, size);
 }
 
+// average cache miss ratio (misses per triangle) of a FIFO post-transform cache
+static double computeACMR(const uint32_t* indices, uint32_t numIndices, uint32_t numVertices, uint32_t cacheSize)
+{
+  if(numIndices < 3)
+  {
+    return 0;
+  }
+
+  std::vector<uint32_t> stamps(numVertices, 0);
+  uint32_t              time   = cacheSize + 1;
+  uint32_t              misses = 0;
+
+  for(uint32_t i = 0; i < numIndices; i++)
+  {
+    uint32_t v = indices[i];
+    if(time - stamps[v] > cacheSize)
+    {
+      stamps[v] = time++;
+      misses++;
+    }
+  }
+
+  return double(misses) / double(numIndices / 3);
+}
+
+// Reorders the triangles in-place for post-transform vertex cache locality,
+// following "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+// (Sander, Nehab, Barczak 2007), aka Tipsify.
+static void tipsifyIndices(uint32_t* indices, uint32_t numIndices, uint32_t cacheSize)
+{
+  uint32_t numTris = numIndices / 3;
+  if(numTris < 2)
+  {
+    return;
+  }
+
+  // compact the referenced vertices to local ids
+
+  std::vector<uint32_t> local(indices, indices + numTris * 3);
+  uint32_t              numVertices = 0;
+  {
+    std::vector<uint32_t> sorted(local);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    for(auto& idx : local)
+    {
+      idx = uint32_t(std::lower_bound(sorted.begin(), sorted.end(), idx) - sorted.begin());
+    }
+    numVertices = uint32_t(sorted.size());
+  }
+
+  // vertex to triangle adjacency
+
+  std::vector<uint32_t> live(numVertices, 0);
+  std::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+  std::vector<uint32_t> adjacencyTris(numTris * 3);
+
+  for(uint32_t i = 0; i < numTris * 3; i++)
+  {
+    live[local[i]]++;
+  }
+  for(uint32_t v = 0; v < numVertices; v++)
+  {
+    adjacencyOffsets[v + 1] = adjacencyOffsets[v] + live[v];
+  }
+  {
+    std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for(uint32_t i = 0; i < numTris * 3; i++)
+    {
+      adjacencyTris[fill[local[i]]++] = i / 3;
+    }
+  }
+
+  std::vector<uint32_t> cacheTime(numVertices, 0);
+  std::vector<uint8_t>  emitted(numTris, 0);
+  std::vector<uint32_t> deadEnds;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> output;
+  output.reserve(numTris * 3);
+
+  uint32_t time   = cacheSize + 1;
+  uint32_t cursor = 0;
+  uint32_t fan    = 0;
+
+  while(fan != ~0u)
+  {
+    candidates.clear();
+
+    for(uint32_t a = adjacencyOffsets[fan]; a < adjacencyOffsets[fan + 1]; a++)
+    {
+      uint32_t t = adjacencyTris[a];
+      if(emitted[t])
+        continue;
+
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        uint32_t v = local[t * 3 + k];
+        output.push_back(indices[t * 3 + k]);
+        deadEnds.push_back(v);
+        candidates.push_back(v);
+        live[v]--;
+        if(time - cacheTime[v] > cacheSize)
+        {
+          cacheTime[v] = time++;
+        }
+      }
+      emitted[t] = 1;
+    }
+
+    // pick the candidate that stays longest in the cache after emitting its fan
+    uint32_t next     = ~0u;
+    uint32_t priority = 0;
+    for(uint32_t v : candidates)
+    {
+      if(!live[v])
+        continue;
+
+      uint32_t p = 0;
+      if(time - cacheTime[v] + 2 * live[v] <= cacheSize)
+      {
+        p = time - cacheTime[v];
+      }
+      if(next == ~0u || p > priority)
+      {
+        next     = v;
+        priority = p;
+      }
+    }
+
+    if(next == ~0u)
+    {
+      // dead end, try recently referenced vertices first, then input order
+      while(!deadEnds.empty() && next == ~0u)
+      {
+        uint32_t v = deadEnds.back();
+        deadEnds.pop_back();
+        if(live[v])
+        {
+          next = v;
+        }
+      }
+      while(next == ~0u && cursor < numVertices)
+      {
+        if(live[cursor])
+        {
+          next = cursor;
+        }
+        cursor++;
+      }
+    }
+
+    fan = next;
+  }
+
+  memcpy(indices, output.data(), sizeof(uint32_t) * numTris * 3);
+}
+
+// Reorders the triangles of every part for vertex cache locality and then
+// renumbers the vertices in order of first use, so that the vertices
+// referenced by a meshlet are mostly contiguous in memory.
+// Operates in-place on the file data, only the first vertex channel is kept
+// consistent.
+static void optimizeGeometryOrder(CSFGeometry* csfgeom)
+{
+  const uint32_t cacheSize = 32;
+
+  uint32_t indexOffset = 0;
+  for(int p = 0; p < csfgeom->numParts; p++)
+  {
+    tipsifyIndices(csfgeom->indexSolid + indexOffset, csfgeom->parts[p].numIndexSolid, cacheSize);
+    indexOffset += csfgeom->parts[p].numIndexSolid;
+  }
+
+  uint32_t              numVertices = uint32_t(csfgeom->numVertices);
+  std::vector<uint32_t> remap(numVertices, ~0u);
+  uint32_t              numRemapped = 0;
+
+  for(int i = 0; i < csfgeom->numIndexSolid; i++)
+  {
+    uint32_t& v = remap[csfgeom->indexSolid[i]];
+    if(v == ~0u)
+    {
+      v = numRemapped++;
+    }
+  }
+  for(int i = 0; i < csfgeom->numIndexWire; i++)
+  {
+    uint32_t& v = remap[csfgeom->indexWire[i]];
+    if(v == ~0u)
+    {
+      v = numRemapped++;
+    }
+  }
+  for(uint32_t v = 0; v < numVertices; v++)
+  {
+    if(remap[v] == ~0u)
+    {
+      remap[v] = numRemapped++;
+    }
+  }
+
+  for(int i = 0; i < csfgeom->numIndexSolid; i++)
+  {
+    csfgeom->indexSolid[i] = remap[csfgeom->indexSolid[i]];
+  }
+  for(int i = 0; i < csfgeom->numIndexWire; i++)
+  {
+    csfgeom->indexWire[i] = remap[csfgeom->indexWire[i]];
+  }
+
+  auto permute = [&](float* data, uint32_t components) {
+    if(!data)
+      return;
+
+    std::vector<float> original(data, data + numVertices * components);
+    for(uint32_t v = 0; v < numVertices; v++)
+    {
+      memcpy(data + remap[v] * components, original.data() + v * components, sizeof(float) * components);
+    }
+  };
+
+  permute(csfgeom->vertex, 3);
+  permute(csfgeom->normal, 3);
+  permute(csfgeom->tex, 2);
+}
+
+// Collapses vertices whose position, normal and texcoord fall into the same
+// cell of an epsilon grid (bitwise equal with epsilon 0), remaps the indices and
+// compacts the vertices, keeping the order of first occurrence.
+// Operates in-place on the file data, only the first vertex channel is kept
+// consistent. Returns the number of removed vertices.
+static uint32_t weldGeometryVertices(CSFGeometry* csfgeom, float epsilon)
+{
+  uint32_t numVertices   = uint32_t(csfgeom->numVertices);
+  uint32_t numComponents = csfgeom->tex ? 8 : 6;
+
+  // one integer key per component, vertices only compare equal if all keys do
+  std::vector<uint64_t> keys(size_t(numVertices) * numComponents);
+  for(uint32_t v = 0; v < numVertices; v++)
+  {
+    for(uint32_t c = 0; c < numComponents; c++)
+    {
+      float value = c < 3 ? csfgeom->vertex[v * 3 + c] : c < 6 ? csfgeom->normal[v * 3 + c - 3] : csfgeom->tex[v * 2 + c - 6];
+
+      uint64_t key;
+      if(epsilon > 0.0f)
+      {
+        key = uint64_t(int64_t(floor(double(value) / double(epsilon))));
+      }
+      else
+      {
+        // treat -0 and +0 alike
+        value        = value == 0.0f ? 0.0f : value;
+        uint32_t raw = 0;
+        memcpy(&raw, &value, sizeof(raw));
+        key = raw;
+      }
+      keys[size_t(v) * numComponents + c] = key;
+    }
+  }
+
+  // open addressing hash table of the first vertex per key
+  uint32_t tableSize = 1;
+  while(tableSize < numVertices * 2)
+  {
+    tableSize <<= 1;
+  }
+  std::vector<uint32_t> table(tableSize, ~0u);
+  std::vector<uint32_t> remap(numVertices);
+  uint32_t              numWelded = 0;
+
+  for(uint32_t v = 0; v < numVertices; v++)
+  {
+    const uint64_t* vkeys = &keys[size_t(v) * numComponents];
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for(uint32_t c = 0; c < numComponents; c++)
+    {
+      hash = (hash ^ vkeys[c]) * 0x100000001b3ull;
+      hash ^= hash >> 29;
+    }
+
+    uint32_t slot = uint32_t(hash) & (tableSize - 1);
+    while(table[slot] != ~0u && memcmp(&keys[size_t(table[slot]) * numComponents], vkeys, sizeof(uint64_t) * numComponents) != 0)
+    {
+      slot = (slot + 1) & (tableSize - 1);
+    }
+
+    if(table[slot] == ~0u)
+    {
+      table[slot] = v;
+      remap[v]    = numWelded++;
+
+      // first occurrences move down only, safe in-place
+      memmove(csfgeom->vertex + remap[v] * 3, csfgeom->vertex + v * 3, sizeof(float) * 3);
+      memmove(csfgeom->normal + remap[v] * 3, csfgeom->normal + v * 3, sizeof(float) * 3);
+      if(csfgeom->tex)
+      {
+        memmove(csfgeom->tex + remap[v] * 2, csfgeom->tex + v * 2, sizeof(float) * 2);
+      }
+    }
+    else
+    {
+      remap[v] = remap[table[slot]];
+    }
+  }
+
+  for(int i = 0; i < csfgeom->numIndexSolid; i++)
+  {
+    csfgeom->indexSolid[i] = remap[csfgeom->indexSolid[i]];
+  }
+  for(int i = 0; i < csfgeom->numIndexWire; i++)
+  {
+    csfgeom->indexWire[i] = remap[csfgeom->indexWire[i]];
+  }
+
+  csfgeom->numVertices = int(numWelded);
+
+  return numVertices - numWelded;
+}
+
+// meshlets in index order, without early culling information
+static void appendMeshletStats(const CSFGeometry* csfgeom, uint32_t maxVertexCount, uint32_t maxPrimitiveCount, NVMeshlet::Stats& stats)
+{
+  NVMeshlet::PackBasicBuilder meshletBuilder{};
+  meshletBuilder.setup(maxVertexCount, maxPrimitiveCount, false);
+
+  NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometry;
+
+  uint32_t indexOffset = 0;
+  for(int p = 0; p < csfgeom->numParts; p++)
+  {
+    meshletBuilder.buildMeshlets<uint32_t>(meshletGeometry, csfgeom->parts[p].numIndexSolid, csfgeom->indexSolid + indexOffset);
+    indexOffset += csfgeom->parts[p].numIndexSolid;
+  }
+
+  meshletBuilder.appendStats(meshletGeometry, stats);
+}
+
+// Drops the pages that lie completely within the range from the process,
+// pages at the ends may be shared with neighboring data. The mapping stays
+// valid, touching the range again reads the file.
+// On Windows the clean pages of the read-only mapping are left to the OS.
+static void releaseMappedPages(const void* data, size_t size)
+{
+#if !defined(_WIN32)
+  static const uintptr_t pageSize = uintptr_t(sysconf(_SC_PAGESIZE));
+
+  uintptr_t begin = (uintptr_t(data) + pageSize - 1) & ~(pageSize - 1);
+  uintptr_t end   = (uintptr_t(data) + size) & ~(pageSize - 1);
+  if(data && end > begin)
+  {
+    madvise((void*)begin, end - begin, MADV_DONTNEED);
+  }
+#endif
+}
+
+static void releaseMappedGeometry(const CSFGeometry* csfgeom)
+{
+  releaseMappedPages(csfgeom->vertex, sizeof(float) * 3 * csfgeom->numVertices);
+  releaseMappedPages(csfgeom->normal, sizeof(float) * 3 * csfgeom->numVertices);
+  releaseMappedPages(csfgeom->tex, sizeof(float) * 2 * csfgeom->numVertices);
+  releaseMappedPages(csfgeom->indexSolid, sizeof(uint32_t) * csfgeom->numIndexSolid);
+  releaseMappedPages(csfgeom->indexWire, sizeof(uint32_t) * csfgeom->numIndexWire);
+}
+
+// The mapped file is read-only, the in-place vertex weld and reordering work
+// on a private copy of the geometry's vertices and indices instead.
+static void copyMappedGeometry(CSFGeometry* csfgeom, std::vector<uint8_t>& storage)
+{
+  size_t numVertices = size_t(csfgeom->numVertices);
+  size_t sizeVertex  = sizeof(float) * 3 * numVertices;
+  size_t sizeTex     = csfgeom->tex ? sizeof(float) * 2 * numVertices : 0;
+  size_t sizeSolid   = sizeof(uint32_t) * csfgeom->numIndexSolid;
+  size_t sizeWire    = csfgeom->indexWire ? sizeof(uint32_t) * csfgeom->numIndexWire : 0;
+
+  storage.resize(sizeVertex * 2 + sizeTex + sizeSolid + sizeWire);
+
+  uint8_t* data = storage.data();
+  auto     copy = [&](auto*& pointer, size_t size) {
+    if(pointer)
+    {
+      memcpy(data, pointer, size);
+      pointer = (std::remove_reference_t<decltype(pointer)>)data;
+      data += size;
+    }
+  };
+
+  const CSFGeometry mapped = *csfgeom;
+  copy(csfgeom->vertex, sizeVertex);
+  copy(csfgeom->normal, sizeVertex);
+  copy(csfgeom->tex, sizeTex);
+  copy(csfgeom->indexSolid, sizeSolid);
+  copy(csfgeom->indexWire, sizeWire);
+
+  releaseMappedGeometry(&mapped);
+}
+
+void CadScene::releaseGeometrySource(const CSFGeometry* csfgeom, int geometry)
+{
+  if(m_sourceCopies.empty())
+  {
+    return;
+  }
+
+  if(m_sourceCopies[geometry].empty())
+  {
+    releaseMappedGeometry(csfgeom);
+  }
+  else
+  {
+    m_sourceCopies[geometry] = std::vector<uint8_t>();
+  }
+}
+
 bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones, int cloneaxis)
 {
   CSFile* csf;
@@ -98,8 +618,30 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
   CSFileMemoryPTR csfmem = CSFileMemory_new();
 
-  if(CSFile_loadExt(&csf, filename, csfmem) != CADSCENEFILE_NOERROR
-     || !(csf->fileFlags & (CADSCENEFILE_FLAG_UNIQUENODES | CADSCENEFILE_FLAG_STRIPS)))
+  // the mapped file stays read-only, the header, geometries and nodes
+  // are copied as they are modified during loading
+  const CSFile* csfMapped = nullptr;
+  if(cfg.mapFile && CSFile_loadReadOnly(&csfMapped, filename, csfmem) == CADSCENEFILE_NOERROR)
+  {
+    csf             = (CSFile*)CSFileMemory_alloc(csfmem, sizeof(CSFile), csfMapped);
+    csf->geometries = (CSFGeometry*)CSFileMemory_alloc(csfmem, sizeof(CSFGeometry) * csf->numGeometries, csfMapped->geometries);
+    csf->nodes      = (CSFNode*)CSFileMemory_alloc(csfmem, sizeof(CSFNode) * csf->numNodes, csfMapped->nodes);
+  }
+  else
+  {
+    if(cfg.mapFile)
+    {
+      LOGI("csf mapping: not supported for %s (compressed or gltf), loading regularly\n", filename)
+    }
+
+    if(CSFile_loadExt(&csf, filename, csfmem) != CADSCENEFILE_NOERROR)
+    {
+      CSFileMemory_delete(csfmem);
+      return false;
+    }
+  }
+
+  if(!(csf->fileFlags & (CADSCENEFILE_FLAG_UNIQUENODES | CADSCENEFILE_FLAG_STRIPS)))
   {
     CSFileMemory_delete(csfmem);
     return false;
@@ -107,7 +649,12 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
   m_cfg = cfg;
 
-  int copies = clones + 1;
+  // geometries release their mapped source once converted, see releaseGeometrySource
+  const bool buildMeshlets = cfg.meshPrimitiveCount && cfg.meshVertexCount;
+  if(csfMapped)
+  {
+    m_sourceCopies.resize(csf->numGeometries);
+  }
 
   {
     // propagate scale onto matrix tree
@@ -142,6 +689,8 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
   m_iboSize  = 0;
   m_meshSize = 0;
 
+  m_meshletErrors = 0;
+
   // geometry
   int numGeoms = csf->numGeometries;
   m_geometry.resize(csf->numGeometries);
@@ -163,55 +712,128 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
   m_bboxes.resize(numBboxes);
 
+  if(m_progress)
+  {
+    m_progress->numGeometries = uint32_t(csf->numGeometries);
+  }
+
+  NVMeshlet::Stats orderStatsBefore;
+  NVMeshlet::Stats orderStatsAfter;
+  double           orderACMRBefore = 0;
+  double           orderACMRAfter  = 0;
+
+  size_t weldVerticesRemoved = 0;
+  size_t weldMeshletsBefore  = 0;
+  size_t weldMeshletsAfter   = 0;
+
 #pragma omp parallel for
   for(int g = 0; g < csf->numGeometries; g++)
   {
     CSFGeometry* csfgeom = &csf->geometries[g];
     Geometry&    geom    = m_geometry[g];
 
-    geom.numVertices   = csfgeom->numVertices;
-    geom.numIndexSolid = csfgeom->numIndexSolid;
-
-    geom.useShorts = geom.numVertices < 0xFFFF && m_cfg.allowShorts;
-    geom.meshSize  = 0;
+    if(csfMapped && (m_cfg.weldVertices || m_cfg.optimizeVertexOrder))
+    {
+      copyMappedGeometry(csfgeom, m_sourceCopies[g]);
+    }
 
-    geom.vboSize = getVertexSize() * csfgeom->numVertices;
-    geom.aboSize = getVertexAttributeSize() * csfgeom->numVertices;
+    if(m_cfg.weldVertices)
+    {
+      NVMeshlet::Stats statsBefore;
+      NVMeshlet::Stats statsAfter;
+      uint32_t         numVerticesBefore = uint32_t(csfgeom->numVertices);
 
-    geom.vboData = malloc(geom.vboSize);
-    geom.aboData = malloc(geom.aboSize);
+      if(m_cfg.verbose)
+      {
+        appendMeshletStats(csfgeom, m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, statsBefore);
+      }
 
-    memset(geom.aboData, 0, geom.aboSize);
+      uint32_t removed = weldGeometryVertices(csfgeom, m_cfg.weldEpsilon);
 
-    const bool colorizeExtra = true;
+      if(m_cfg.verbose && removed)
+      {
+        appendMeshletStats(csfgeom, m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, statsAfter);
+        LOGI("vertex weld: geometry %5d: vertices %8d -> %8d, meshlets %6zu -> %6zu\n", g, numVerticesBefore,
+             csfgeom->numVertices, statsBefore.meshletsTotal, statsAfter.meshletsTotal)
+      }
+      else
+      {
+        statsAfter = statsBefore;
+      }
+
+#pragma omp critical
+      {
+        weldVerticesRemoved += removed;
+        weldMeshletsBefore += statsBefore.meshletsTotal;
+        weldMeshletsAfter += statsAfter.meshletsTotal;
+      }
+    }
+
+    if(m_cfg.optimizeVertexOrder)
+    {
+      NVMeshlet::Stats statsBefore;
+      NVMeshlet::Stats statsAfter;
+      double           acmrBefore = 0;
+      double           acmrAfter  = 0;
+
+      if(m_cfg.verbose)
+      {
+        acmrBefore = computeACMR(csfgeom->indexSolid, csfgeom->numIndexSolid, csfgeom->numVertices, 32);
+        appendMeshletStats(csfgeom, m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, statsBefore);
+      }
+
+      optimizeGeometryOrder(csfgeom);
+
+      if(m_cfg.verbose)
+      {
+        acmrAfter = computeACMR(csfgeom->indexSolid, csfgeom->numIndexSolid, csfgeom->numVertices, 32);
+        appendMeshletStats(csfgeom, m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, statsAfter);
+      }
+
+#pragma omp critical
+      {
+        orderStatsBefore.append(statsBefore);
+        orderStatsAfter.append(statsAfter);
+        orderACMRBefore += acmrBefore * double(csfgeom->numIndexSolid / 3);
+        orderACMRAfter += acmrAfter * double(csfgeom->numIndexSolid / 3);
+      }
+    }
+
+    geom.numVertices   = csfgeom->numVertices;
+    geom.numIndexSolid = csfgeom->numIndexSolid;
+
+    geom.useShorts = geom.numVertices < 0xFFFF && m_cfg.allowShorts;
+    geom.meshSize  = 0;
+
+    geom.vboSize = getVertexSize() * csfgeom->numVertices;
+    geom.aboSize = getVertexAttributeSize() * csfgeom->numVertices;
+
+    geom.vboData = malloc(geom.vboSize);
+    geom.aboData = malloc(geom.aboSize);
+
+    memset(geom.aboData, 0, geom.aboSize);
+
+    const bool colorizeExtra = true;
 
     if(m_cfg.fp16)
     {
+      floatToHalfVectors((half*)geom.vboData, getVertexSize() / sizeof(half), csfgeom->vertex, csfgeom->numVertices, 1.0f);
+      floatToHalfVectors((half*)geom.aboData, getVertexAttributeSize() / sizeof(half), csfgeom->normal,
+                         csfgeom->numVertices, 0.0f);
+
+      VertexAttributesFP16 extra;
+      floatToHalfVector(extra.normal, nvmath::vec4f(0, 1, 0, 0) * 0.1f);
+
       for(uint32_t i = 0; i < uint32_t(csfgeom->numVertices); i++)
       {
-        VertexFP16*           vertex    = (VertexFP16*)getVertex(geom.vboData, i);
         VertexAttributesFP16* attribute = (VertexAttributesFP16*)getVertexAttribute(geom.aboData, i);
 
-        nvmath::vec4f position;
-        nvmath::vec4f normal;
-        position[0] = csfgeom->vertex[3 * i + 0];
-        position[1] = csfgeom->vertex[3 * i + 1];
-        position[2] = csfgeom->vertex[3 * i + 2];
-        position[3] = 1.0f;
-        normal[0]   = csfgeom->normal[3 * i + 0];
-        normal[1]   = csfgeom->normal[3 * i + 1];
-        normal[2]   = csfgeom->normal[3 * i + 2];
-        normal[3]   = 0.0f;
-
-        floatToHalfVector(vertex->position, position);
-        floatToHalfVector(attribute->normal, normal);
-
         for(uint32_t i = 0; m_cfg.colorizeExtra && i < m_cfg.extraAttributes; i++)
         {
-          floatToHalfVector(attribute[1 + i].normal, nvmath::vec4f(0, 1, 0, 0) * 0.1f);
+          attribute[1 + i] = extra;
         }
 
-        m_bboxes[g].merge(position);
+        m_bboxes[g].merge(nvmath::vec4f(csfgeom->vertex[3 * i + 0], csfgeom->vertex[3 * i + 1], csfgeom->vertex[3 * i + 2], 1.0f));
       }
     }
     else
@@ -296,6 +918,17 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
       accumSolid += csfgeom->parts[p].numIndexSolid;
     }
 
+    if(!buildMeshlets)
+    {
+      releaseGeometrySource(csfgeom, g);
+    }
+    else if(csfMapped && m_sourceCopies[g].empty())
+    {
+      // the meshlet build maps the pages again, mostly from the OS file cache,
+      // so only the geometries in progress stay resident
+      releaseMappedGeometry(csfgeom);
+    }
+
 #pragma omp critical
     {
       tshorts += geom.useShorts;
@@ -304,10 +937,41 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
       m_vboSize += geom.vboSize + geom.aboSize;
       m_iboSize += geom.iboSize;
     }
+
+    if(m_progress)
+    {
+      m_progress->geometries++;
+    }
   }
 
   LOGI("geometries: shorts %d, total %d\n", tshorts, ttotal)
 
+  if(m_cfg.weldVertices)
+  {
+    size_t savedBytes = weldVerticesRemoved * (getVertexSize() + getVertexAttributeSize());
+    LOGI("vertex weld: %zu vertices removed, %zu KB saved\n", weldVerticesRemoved, savedBytes / 1024)
+    if(m_cfg.verbose)
+    {
+      LOGI("vertex weld: meshlets %zu -> %zu\n", weldMeshletsBefore, weldMeshletsAfter)
+    }
+  }
+
+  if(m_cfg.optimizeVertexOrder && m_cfg.verbose)
+  {
+    size_t numTriangles = 0;
+    for(int g = 0; g < csf->numGeometries; g++)
+    {
+      numTriangles += csf->geometries[g].numIndexSolid / 3;
+    }
+    numTriangles = std::max(numTriangles, size_t(1));
+
+    LOGI("vertex order: acmr %.3f -> %.3f\n", orderACMRBefore / double(numTriangles), orderACMRAfter / double(numTriangles))
+    LOGI("vertex order: meshlets before\n")
+    orderStatsBefore.fprint(stdout);
+    LOGI("vertex order: meshlets after\n")
+    orderStatsAfter.fprint(stdout);
+  }
+
 
   srand(63546);
   std::vector<nvmath::vec4f> geometryColors(csf->numGeometries);
@@ -318,7 +982,7 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
   // nodes
   int numObjects = 0;
-  m_matrices.resize(csf->numNodes * copies);
+  m_matrices.resize(csf->numNodes);
   for(int n = 0; n < csf->numNodes; n++)
   {
     CSFNode* csfnode = &csf->nodes[n];
@@ -349,7 +1013,7 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
 
   // objects
-  m_objects.resize(numObjects * copies);
+  m_objects.resize(numObjects);
   numObjects   = 0;
   int numParts = 0;
   for(int n = 0; n < csf->numNodes; n++)
@@ -389,6 +1053,29 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
   }
   m_numObjectParts = numParts;
 
+  setupCopies(clones, cloneaxis, csf->rootIDX);
+
+  if(buildMeshlets)
+  {
+    std::string cacheFilename = std::string(filename) + ".meshletcache";
+    buildMeshletTopology(csf, cfg.meshletCache ? cacheFilename.c_str() : nullptr);
+  }
+
+  m_sourceCopies.clear();
+  CSFileMemory_delete(csfmem);
+
+  return true;
+}
+
+void CadScene::setupCopies(int clones, int cloneaxis, int rootIDX)
+{
+  int copies = clones + 1;
+
+  m_rootIDX = rootIDX;
+
+  m_copyOffsets.resize(copies);
+  m_copyOffsets[0] = nvmath::vec4f(0, 0, 0, 0);
+
   // compute clone move delta based on m_bbox;
 
   nvmath::vec4f dim = m_bbox.max - m_bbox.min;
@@ -427,8 +1114,6 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
   for(int c = 1; c <= clones; c++)
   {
-    int numNodes = csf->numNodes;
-
     nvmath::vec4f shift = dim * 1.05f;
 
     float u = 0;
@@ -490,46 +1175,23 @@ bool CadScene::loadCSF(const char* filename, const LoadConfig& cfg, int clones,
 
     shift.w = 0;
 
-    // move all world matrices
-    for(int n = 0; n < numNodes; n++)
-    {
-      MatrixNode& node = m_matrices[n + numNodes * c];
-      node             = m_matrices[n];
-      node.worldMatrix.set_col(3, node.worldMatrix.col(3) + shift);
-    }
-
-    {
-      // patch object matrix of root
-      MatrixNode& node = m_matrices[csf->rootIDX + numNodes * c];
-      node.objectMatrix.set_col(3, node.objectMatrix.col(3) + shift);
-    }
-
-    // clone objects
-    for(int n = 0; n < numObjects; n++)
-    {
-      const Object& objectorig = m_objects[n];
-      Object&       object     = m_objects[n + numObjects * c];
-
-      object = objectorig;
-      object.matrixIndex += c * numNodes;
-      for(auto& part : object.parts)
-      {
-        part.matrixIndex += c * numNodes;
-      }
+    m_copyOffsets[c] = shift;
 
-      BBox bbox = m_bboxes[object.geometryIndex].transformed(m_matrices[object.matrixIndex].worldMatrix);
-      m_bboxInstanced.merge(bbox);
-    }
+    // m_bbox covers all objects, copies only translate them
+    BBox bbox;
+    bbox.min = m_bbox.min + shift;
+    bbox.max = m_bbox.max + shift;
+    m_bboxInstanced.merge(bbox);
   }
+}
 
-  if(cfg.meshPrimitiveCount && cfg.meshVertexCount)
+void CadScene::getCopyNodes(CopyNode* nodes) const
+{
+  for(size_t c = 0; c < m_copyOffsets.size(); c++)
   {
-    buildMeshletTopology(csf);
+    nodes[c]        = {};
+    nodes[c].offset = m_copyOffsets[c];
   }
-
-  CSFileMemory_delete(csfmem);
-
-  return true;
 }
 
 void CadScene::unload()
@@ -542,6 +1204,8 @@ void CadScene::unload()
   m_geometry.clear();
   m_objects.clear();
   m_bboxes.clear();
+  m_copyOffsets.clear();
+  m_bakedMapping.reset();
 }
 
 
@@ -574,6 +1238,7 @@ size_t fillIndexBuffer(int useShorts, const std::vector<unsigned int>& vertexind
   return vidxSize;
 }
 
+// takes over the builder's output, no copy
 void fillMeshletTopology(NVMeshlet::PackBasicBuilder::MeshletGeometry& geometry, CadScene::MeshletTopology& topo, int useShorts)
 {
   (void)useShorts;
@@ -583,102 +1248,1936 @@ void fillMeshletTopology(NVMeshlet::PackBasicBuilder::MeshletGeometry& geometry,
   topo.descSize = sizeof(NVMeshlet::MeshletPackBasicDesc) * geometry.meshletDescriptors.size();
   topo.primSize = sizeof(NVMeshlet::PackBasicType) * geometry.meshletPacks.size();
 
-  topo.descData = malloc(topo.descSize);
-  topo.primData = malloc(topo.primSize);
+  topo.descData = std::move(geometry.meshletDescriptors);
+  topo.primData = std::move(geometry.meshletPacks);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// meshlet cache
+//
+// { MeshletCacheHeader, MeshletCacheGeometry[numGeometries], data... }
+// data per geometry (16 byte aligned): MeshletRange[numParts * 2] (solid, lod), descriptors, packs
+
+// bump whenever the meshlet builder output changes
+#define MESHLET_CACHE_VERSION 3
+#define MESHLET_CACHE_MAGIC 0x43544c4d  // "MLTC"
+#define MESHLET_CACHE_ALIGN 16
 
-  memcpy(topo.descData, geometry.meshletDescriptors.data(), topo.descSize);
-  memcpy(topo.primData, geometry.meshletPacks.data(), topo.primSize);
+struct MeshletCacheHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numGeometries;
+  uint32_t _pad;
+};
+
+struct MeshletCacheGeometry
+{
+  uint64_t hash;
+  uint64_t partsOffset;
+  uint64_t descOffset;
+  uint64_t descSize;
+  uint64_t primOffset;
+  uint64_t primSize;
+  uint32_t numParts;
+  uint32_t numMeshlets;
+};
+
+// FNV-1a over 32-bit words
+static uint64_t hashFNV1a(uint64_t hash, const void* data, size_t size)
+{
+  assert(size % sizeof(uint32_t) == 0);
+
+  const uint32_t* words = (const uint32_t*)data;
+  for(size_t i = 0; i < size / sizeof(uint32_t); i++)
+  {
+    hash ^= words[i];
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
 }
 
+static uint64_t hashMeshletInput(const CSFGeometry* csfgeom, const CadScene::LoadConfig& cfg)
+{
+  const uint32_t config[] = {MESHLET_CACHE_VERSION,
+                             cfg.meshVertexCount,
+                             cfg.meshPrimitiveCount,
+                             uint32_t(cfg.meshBuilder),
+                             cfg.meshEncoding,
+                             cfg.meshPositionBits,
+                             cfg.meshTaskPadding,
+                             uint32_t(cfg.meshletMergeParts),
+                             uint32_t(cfg.meshletLod),
+                             uint32_t(cfg.meshletStrips),
+                             uint32_t(csfgeom->numParts),
+                             uint32_t(csfgeom->numVertices),
+                             uint32_t(csfgeom->numIndexSolid)};
+
+  uint64_t hash = hashFNV1a(0xcbf29ce484222325ull, config, sizeof(config));
+  for(int p = 0; p < csfgeom->numParts; p++)
+  {
+    hash = hashFNV1a(hash, &csfgeom->parts[p].numIndexSolid, sizeof(uint32_t));
+  }
+  // positions affect early culling and quantized positions
+  hash = hashFNV1a(hash, csfgeom->indexSolid, sizeof(uint32_t) * csfgeom->numIndexSolid);
+  hash = hashFNV1a(hash, csfgeom->vertex, sizeof(float) * 3 * csfgeom->numVertices);
+
+  return hash;
+}
 
-void CadScene::buildMeshletTopology(const CSFile* csf)
+uint32_t CadScene::loadMeshletCache(const char* filename, const std::vector<uint64_t>& hashes, std::vector<uint8_t>& cached)
 {
-  NVMeshlet::Stats statsGlobal;
-  uint32_t         groups              = 0;
-  size_t           meshActualSizeTotal = 0;
+  nvh::FileReadMapping mapping;
+  if(!mapping.open(filename))
+  {
+    return 0;
+  }
 
-#define MESHLET_ERRORCHECK 0
+  const uint8_t* data = (const uint8_t*)mapping.data();
+  size_t         size = mapping.size();
 
-  if(m_cfg.meshBuilder == MESHLET_BUILDER_PACKBASIC)
+  const MeshletCacheHeader* header = (const MeshletCacheHeader*)data;
+  if(size < sizeof(MeshletCacheHeader) || header->magic != MESHLET_CACHE_MAGIC || header->version != MESHLET_CACHE_VERSION
+     || header->numGeometries != m_geometry.size()
+     || size < sizeof(MeshletCacheHeader) + sizeof(MeshletCacheGeometry) * header->numGeometries)
   {
-    NVMeshlet::PackBasicBuilder meshletBuilder{};
-    meshletBuilder.setup(m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, false);
+    return 0;
+  }
 
-#pragma omp parallel for
-    for(int g = 0; g < csf->numGeometries; g++)
+  auto isInFile = [&](uint64_t offset, uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+
+  const MeshletCacheGeometry* entries = (const MeshletCacheGeometry*)(header + 1);
+
+  uint32_t numCached = 0;
+#pragma omp parallel for reduction(+ : numCached)
+  for(int g = 0; g < int(m_geometry.size()); g++)
+  {
+    const MeshletCacheGeometry& entry = entries[g];
+    Geometry&                   geom  = m_geometry[g];
+
+    if(entry.hash != hashes[g] || entry.numParts != geom.parts.size()
+       || !isInFile(entry.partsOffset, sizeof(MeshletRange) * 2 * entry.numParts) || !isInFile(entry.descOffset, entry.descSize)
+       || !isInFile(entry.primOffset, entry.primSize) || entry.descSize % sizeof(NVMeshlet::MeshletPackBasicDesc)
+       || entry.primSize % sizeof(NVMeshlet::PackBasicType))
     {
-      const CSFGeometry* csfgeom = csf->geometries + g;
-      Geometry&          geom    = m_geometry[g];
+      continue;
+    }
 
-      NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometry;
+    const MeshletRange* ranges = (const MeshletRange*)(data + entry.partsOffset);
+    for(size_t p = 0; p < geom.parts.size(); p++)
+    {
+      geom.parts[p].meshSolid = ranges[p * 2 + 0];
+      geom.parts[p].meshLod   = ranges[p * 2 + 1];
+    }
 
-      uint32_t               numMeshlets = 0;
-      uint32_t               indexOffset = 0;
-      const unsigned int*    indices     = csfgeom->indexSolid;
-      const CSFGeometryPart* parts       = csfgeom->parts;
-      for(size_t p = 0; p < geom.parts.size(); p++)
-      {
-        uint32_t numIndex              = parts[p].numIndexSolid;
-        geom.parts[p].meshSolid.offset = numMeshlets;
+    geom.meshlet.numMeshlets = int(entry.numMeshlets);
+    if(entry.numMeshlets)
+    {
+      geom.meshlet.descSize = entry.descSize;
+      geom.meshlet.primSize = entry.primSize;
 
-        uint32_t processedIndices = meshletBuilder.buildMeshlets<uint32_t>(meshletGeometry, numIndex, indices + indexOffset);
-        if(processedIndices != numIndex)
-        {
-          LOGE("warning: geometry meshlet incomplete %d\n", g)
-        }
+      const auto* descs = (const NVMeshlet::MeshletPackBasicDesc*)(data + entry.descOffset);
+      const auto* prims = (const NVMeshlet::PackBasicType*)(data + entry.primOffset);
+      geom.meshlet.descData.assign(descs, descs + entry.descSize / sizeof(NVMeshlet::MeshletPackBasicDesc));
+      geom.meshlet.primData.assign(prims, prims + entry.primSize / sizeof(NVMeshlet::PackBasicType));
+    }
 
-        geom.parts[p].meshSolid.count = (uint32_t)meshletGeometry.meshletDescriptors.size() - numMeshlets;
-        numMeshlets                   = (uint32_t)meshletGeometry.meshletDescriptors.size();
-        indexOffset += numIndex;
-      }
+    cached[g] = 1;
+    numCached++;
+  }
 
-      geom.meshlet.numMeshlets = int(meshletGeometry.meshletDescriptors.size());
+  return numCached;
+}
 
-      meshletBuilder.buildMeshletEarlyCulling(meshletGeometry, m_bboxes[g].min.vec_array, m_bboxes[g].max.vec_array,
-                                              (const float*)csfgeom->vertex, sizeof(float) * 3);
-      if(m_cfg.verbose)
-      {
-#if MESHLET_ERRORCHECK
-        NVMeshlet::StatusCode errorcode = meshletBuilder.errorCheck<uint32_t>(meshletGeometry, 0, csfgeom->numVertices - 1,
-                                                                              csfgeom->numIndexSolid, csfgeom->indexSolid);
-        if(errorcode)
-        {
-          LOGE("geometry %d: meshlet error %d\n", g, errorcode);
-        }
-#endif
+bool CadScene::saveMeshletCache(const char* filename, const std::vector<uint64_t>& hashes) const
+{
+  MeshletCacheHeader header = {MESHLET_CACHE_MAGIC, MESHLET_CACHE_VERSION, uint32_t(m_geometry.size()), 0};
 
-        NVMeshlet::Stats statsLocal;
-        meshletBuilder.appendStats(meshletGeometry, statsLocal);
+  std::vector<MeshletCacheGeometry> entries(m_geometry.size());
 
-#pragma omp critical
-        {
-          statsGlobal.append(statsLocal);
-        }
-      }
+  auto alignOffset = [](uint64_t offset) { return (offset + MESHLET_CACHE_ALIGN - 1) & ~uint64_t(MESHLET_CACHE_ALIGN - 1); };
 
-      fillMeshletTopology(meshletGeometry, geom.meshlet, geom.useShorts);
+  uint64_t offset = sizeof(MeshletCacheHeader) + sizeof(MeshletCacheGeometry) * entries.size();
+  for(size_t g = 0; g < m_geometry.size(); g++)
+  {
+    const Geometry&       geom  = m_geometry[g];
+    MeshletCacheGeometry& entry = entries[g];
+
+    entry.hash        = hashes[g];
+    entry.numParts    = uint32_t(geom.parts.size());
+    entry.numMeshlets = uint32_t(geom.meshlet.numMeshlets);
+    entry.descSize    = geom.meshlet.numMeshlets ? geom.meshlet.descSize : 0;
+    entry.primSize    = geom.meshlet.numMeshlets ? geom.meshlet.primSize : 0;
+
+    offset            = alignOffset(offset);
+    entry.partsOffset = offset;
+    offset            = alignOffset(offset + sizeof(MeshletRange) * 2 * entry.numParts);
+    entry.descOffset  = offset;
+    offset            = alignOffset(offset + entry.descSize);
+    entry.primOffset  = offset;
+    offset += entry.primSize;
+  }
 
-      geom.meshSize        = geom.meshlet.descSize;
-      geom.meshIndicesSize = geom.meshlet.primSize;
+  FILE* file = fopen(filename, "wb");
+  if(!file)
+  {
+    return false;
+  }
+
+  uint64_t written   = 0;
+  auto     writeData = [&](const void* data, uint64_t dataOffset, uint64_t dataSize) {
+    static const uint8_t padding[MESHLET_CACHE_ALIGN] = {};
+    assert(dataOffset >= written && dataOffset - written < MESHLET_CACHE_ALIGN);
+    written += fwrite(padding, 1, size_t(dataOffset - written), file);
+    if(dataSize)
+    {
+      written += fwrite(data, 1, size_t(dataSize), file);
+    }
+  };
 
-      size_t meshActualSize = geom.meshlet.descSize + geom.meshlet.primSize;
+  writeData(&header, 0, sizeof(header));
+  writeData(entries.data(), sizeof(header), sizeof(MeshletCacheGeometry) * entries.size());
+  for(size_t g = 0; g < m_geometry.size(); g++)
+  {
+    const Geometry&             geom  = m_geometry[g];
+    const MeshletCacheGeometry& entry = entries[g];
 
-#pragma omp critical
+    std::vector<MeshletRange> ranges(geom.parts.size() * 2);
+    for(size_t p = 0; p < geom.parts.size(); p++)
+    {
+      ranges[p * 2 + 0] = geom.parts[p].meshSolid;
+      ranges[p * 2 + 1] = geom.parts[p].meshLod;
+    }
+
+    writeData(ranges.data(), entry.partsOffset, sizeof(MeshletRange) * 2 * entry.numParts);
+    writeData(geom.meshlet.getDescData(), entry.descOffset, entry.descSize);
+    writeData(geom.meshlet.getPrimData(), entry.primOffset, entry.primSize);
+  }
+
+  bool success = written == offset;
+  fclose(file);
+
+  return success;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// baked scene
+//
+// { BakedHeader, BakedGeometry[numGeometries], sections... }
+// sections (BAKED_ALIGN aligned): materials, matrices, bboxes, objects, object parts,
+// geometry parts, then per geometry: vbo, abo, ibo, meshlet descriptors, meshlet packs
+//
+// Scene copies are not stored, they are set up again at load time.
+// Geometry data is used from the file mapping as is.
+
+// bump whenever the layout or any of the stored structs change
+#define BAKED_VERSION 1
+#define BAKED_MAGIC 0x42465343  // "CSFB"
+// matches the UBO range alignment of Material and MatrixNode
+#define BAKED_ALIGN 256
+
+struct BakedHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numGeometries;
+  uint32_t numMaterials;
+  uint32_t numMatrices;
+  uint32_t numBboxes;
+  uint32_t numObjects;
+  uint32_t numObjectParts;
+  uint32_t numGeometryParts;
+  int32_t  rootIDX;
+
+  // LoadConfig the data was built with
+  uint32_t fp16;
+  uint32_t extraAttributes;
+  uint32_t meshVertexCount;
+  uint32_t meshPrimitiveCount;
+  uint32_t meshBuilder;
+  uint32_t meshEncoding;
+  uint32_t meshPositionBits;
+  uint32_t meshTaskPadding;
+  uint32_t meshletMergeParts;
+  uint32_t meshletLod;
+  uint32_t meshletStrips;
+  uint32_t optimizeVertexOrder;
+  uint32_t weldVertices;
+  float    weldEpsilon;
+  float    scale;
+  uint32_t _pad;
+
+  float bboxMin[4];
+  float bboxMax[4];
+
+  uint64_t materialsOffset;
+  uint64_t matricesOffset;
+  uint64_t bboxesOffset;
+  uint64_t objectsOffset;
+  uint64_t objectPartsOffset;
+  uint64_t geometryPartsOffset;
+};
+
+struct BakedGeometry
+{
+  uint64_t vboOffset;
+  uint64_t vboSize;
+  uint64_t aboOffset;
+  uint64_t aboSize;
+  uint64_t iboOffset;
+  uint64_t iboSize;
+  uint64_t descOffset;
+  uint64_t descSize;
+  uint64_t primOffset;
+  uint64_t primSize;
+  uint32_t partOffset;
+  uint32_t partBboxOffset;
+  uint32_t numParts;
+  uint32_t useShorts;
+  uint32_t numVertices;
+  uint32_t numIndexSolid;
+  uint32_t numMeshlets;
+  uint32_t _pad;
+};
+
+struct BakedGeometryPart
+{
+  uint64_t     indexOffset;
+  uint32_t     indexCount;
+  uint32_t     _pad;
+  CadScene::MeshletRange meshSolid;
+  CadScene::MeshletRange meshLod;
+};
+
+struct BakedObject
+{
+  int32_t  partOffset;
+  int32_t  matrixIndex;
+  int32_t  geometryIndex;
+  int32_t  faceCCW;
+  uint32_t numParts;
+  uint32_t _pad;
+};
+
+static_assert(sizeof(CadScene::ObjectPart) == sizeof(int32_t) * 3, "ObjectPart is stored as is");
+
+bool CadScene::saveBaked(const char* filename) const
+{
+  uint32_t numGeometries = uint32_t(m_geometry.size());
+  uint32_t numMatrices   = uint32_t(m_matrices.size());
+  uint32_t numObjects    = uint32_t(m_objects.size());
+
+  BakedHeader header      = {};
+  header.magic            = BAKED_MAGIC;
+  header.version          = BAKED_VERSION;
+  header.numGeometries    = numGeometries;
+  header.numMaterials     = uint32_t(m_materials.size());
+  header.numMatrices      = numMatrices;
+  header.numBboxes        = uint32_t(m_bboxes.size());
+  header.numObjects       = numObjects;
+  header.numObjectParts   = m_numObjectParts;
+  header.numGeometryParts = m_numGeometryParts;
+  header.rootIDX          = m_rootIDX;
+
+  header.fp16                = m_cfg.fp16 ? 1 : 0;
+  header.extraAttributes     = m_cfg.extraAttributes;
+  header.meshVertexCount     = m_cfg.meshVertexCount;
+  header.meshPrimitiveCount  = m_cfg.meshPrimitiveCount;
+  header.meshBuilder         = uint32_t(m_cfg.meshBuilder);
+  header.meshEncoding        = m_cfg.meshEncoding;
+  header.meshPositionBits    = m_cfg.meshPositionBits;
+  header.meshTaskPadding     = m_cfg.meshTaskPadding;
+  header.meshletMergeParts   = m_cfg.meshletMergeParts ? 1 : 0;
+  header.meshletLod          = m_cfg.meshletLod ? 1 : 0;
+  header.meshletStrips       = m_cfg.meshletStrips ? 1 : 0;
+  header.optimizeVertexOrder = m_cfg.optimizeVertexOrder ? 1 : 0;
+  header.weldVertices        = m_cfg.weldVertices ? 1 : 0;
+  header.weldEpsilon         = m_cfg.weldEpsilon;
+  header.scale               = m_cfg.scale;
+  memcpy(header.bboxMin, m_bbox.min.vec_array, sizeof(header.bboxMin));
+  memcpy(header.bboxMax, m_bbox.max.vec_array, sizeof(header.bboxMax));
+
+  std::vector<BakedGeometry>     geometries(numGeometries);
+  std::vector<BakedGeometryPart> geometryParts(m_numGeometryParts);
+  std::vector<BakedObject>       objects(numObjects);
+  std::vector<ObjectPart>        objectParts;
+  objectParts.reserve(m_numObjectParts);
+
+  for(uint32_t o = 0; o < numObjects; o++)
+  {
+    const Object& object = m_objects[o];
+    objects[o]           = {object.partOffset, object.matrixIndex, object.geometryIndex, object.faceCCW,
+                            uint32_t(object.parts.size()), 0};
+    objectParts.insert(objectParts.end(), object.parts.begin(), object.parts.end());
+  }
+
+  auto alignOffset = [](uint64_t offset) { return (offset + BAKED_ALIGN - 1) & ~uint64_t(BAKED_ALIGN - 1); };
+
+  uint64_t offset     = sizeof(BakedHeader) + sizeof(BakedGeometry) * numGeometries;
+  auto     addSection = [&](uint64_t size) {
+    offset         = alignOffset(offset);
+    uint64_t begin = offset;
+    offset += size;
+    return begin;
+  };
+
+  header.materialsOffset     = addSection(sizeof(Material) * m_materials.size());
+  header.matricesOffset      = addSection(sizeof(MatrixNode) * numMatrices);
+  header.bboxesOffset        = addSection(sizeof(BBox) * m_bboxes.size());
+  header.objectsOffset       = addSection(sizeof(BakedObject) * objects.size());
+  header.objectPartsOffset   = addSection(sizeof(ObjectPart) * objectParts.size());
+  header.geometryPartsOffset = addSection(sizeof(BakedGeometryPart) * geometryParts.size());
+
+  for(uint32_t g = 0; g < numGeometries; g++)
+  {
+    const Geometry& geom  = m_geometry[g];
+    BakedGeometry&  entry = geometries[g];
+
+    entry.partOffset     = uint32_t(geom.partOffset);
+    entry.partBboxOffset = uint32_t(geom.partBboxOffset);
+    entry.numParts       = uint32_t(geom.parts.size());
+    entry.useShorts      = uint32_t(geom.useShorts);
+    entry.numVertices    = uint32_t(geom.numVertices);
+    entry.numIndexSolid  = uint32_t(geom.numIndexSolid);
+    entry.numMeshlets    = uint32_t(geom.meshlet.numMeshlets);
+
+    entry.vboSize    = geom.vboSize;
+    entry.vboOffset  = addSection(entry.vboSize);
+    entry.aboSize    = geom.aboSize;
+    entry.aboOffset  = addSection(entry.aboSize);
+    entry.iboSize    = geom.iboSize;
+    entry.iboOffset  = addSection(entry.iboSize);
+    entry.descSize   = geom.meshlet.numMeshlets ? geom.meshlet.descSize : 0;
+    entry.descOffset = addSection(entry.descSize);
+    entry.primSize   = geom.meshlet.numMeshlets ? geom.meshlet.primSize : 0;
+    entry.primOffset = addSection(entry.primSize);
+
+    for(size_t p = 0; p < geom.parts.size(); p++)
+    {
+      const GeometryPart& part = geom.parts[p];
+      geometryParts[geom.partOffset + p] = {part.indexSolid.offset, uint32_t(part.indexSolid.count), 0,
+                                            part.meshSolid, part.meshLod};
+    }
+  }
+
+  FILE* file = fopen(filename, "wb");
+  if(!file)
+  {
+    return false;
+  }
+
+  uint64_t written   = 0;
+  auto     writeData = [&](const void* data, uint64_t dataOffset, uint64_t dataSize) {
+    static const uint8_t padding[BAKED_ALIGN] = {};
+    assert(dataOffset >= written && dataOffset - written < BAKED_ALIGN);
+    written += fwrite(padding, 1, size_t(dataOffset - written), file);
+    if(dataSize)
+    {
+      written += fwrite(data, 1, size_t(dataSize), file);
+    }
+  };
+
+  writeData(&header, 0, sizeof(header));
+  writeData(geometries.data(), sizeof(header), sizeof(BakedGeometry) * geometries.size());
+  writeData(m_materials.data(), header.materialsOffset, sizeof(Material) * m_materials.size());
+  writeData(m_matrices.data(), header.matricesOffset, sizeof(MatrixNode) * numMatrices);
+  writeData(m_bboxes.data(), header.bboxesOffset, sizeof(BBox) * m_bboxes.size());
+  writeData(objects.data(), header.objectsOffset, sizeof(BakedObject) * objects.size());
+  writeData(objectParts.data(), header.objectPartsOffset, sizeof(ObjectPart) * objectParts.size());
+  writeData(geometryParts.data(), header.geometryPartsOffset, sizeof(BakedGeometryPart) * geometryParts.size());
+  for(uint32_t g = 0; g < numGeometries; g++)
+  {
+    const Geometry&      geom  = m_geometry[g];
+    const BakedGeometry& entry = geometries[g];
+
+    writeData(geom.vboData, entry.vboOffset, entry.vboSize);
+    writeData(geom.aboData, entry.aboOffset, entry.aboSize);
+    writeData(geom.iboData, entry.iboOffset, entry.iboSize);
+    writeData(geom.meshlet.getDescData(), entry.descOffset, entry.descSize);
+    writeData(geom.meshlet.getPrimData(), entry.primOffset, entry.primSize);
+  }
+
+  bool success = written == offset;
+  fclose(file);
+
+  return success;
+}
+
+bool CadScene::loadBaked(const char* filename, const LoadConfig& cfg, int clones, int cloneaxis)
+{
+  if(!m_geometry.empty())
+    return false;
+
+  std::shared_ptr<nvh::FileReadMapping> mapping = std::make_shared<nvh::FileReadMapping>();
+  if(!mapping->open(filename))
+  {
+    return false;
+  }
+
+  const uint8_t* data = (const uint8_t*)mapping->data();
+  size_t         size = mapping->size();
+
+  auto isInFile = [&](uint64_t offset, uint64_t bytes) { return offset <= size && bytes <= size - offset; };
+
+  const BakedHeader* header = (const BakedHeader*)data;
+  if(size < sizeof(BakedHeader) || header->magic != BAKED_MAGIC || header->version != BAKED_VERSION
+     || !isInFile(sizeof(BakedHeader), sizeof(BakedGeometry) * uint64_t(header->numGeometries))
+     || !isInFile(header->materialsOffset, sizeof(Material) * uint64_t(header->numMaterials))
+     || !isInFile(header->matricesOffset, sizeof(MatrixNode) * uint64_t(header->numMatrices))
+     || !isInFile(header->bboxesOffset, sizeof(BBox) * uint64_t(header->numBboxes))
+     || !isInFile(header->objectsOffset, sizeof(BakedObject) * uint64_t(header->numObjects))
+     || !isInFile(header->objectPartsOffset, sizeof(ObjectPart) * uint64_t(header->numObjectParts))
+     || !isInFile(header->geometryPartsOffset, sizeof(BakedGeometryPart) * uint64_t(header->numGeometryParts))
+     || header->numBboxes < header->numGeometries || header->rootIDX < 0 || uint32_t(header->rootIDX) >= header->numMatrices)
+  {
+    LOGE("baked scene: %s is not a compatible .csfbake file\n", filename)
+    return false;
+  }
+
+  // the stored data dictates vertex and meshlet layouts, runtime options come from cfg
+  m_cfg = cfg;
+
+  m_cfg.fp16                = header->fp16 != 0;
+  m_cfg.extraAttributes     = header->extraAttributes;
+  m_cfg.meshVertexCount     = header->meshVertexCount;
+  m_cfg.meshPrimitiveCount  = header->meshPrimitiveCount;
+  m_cfg.meshBuilder         = MeshletBuilderType(header->meshBuilder);
+  m_cfg.meshEncoding        = header->meshEncoding;
+  m_cfg.meshPositionBits    = header->meshPositionBits;
+  m_cfg.meshTaskPadding     = header->meshTaskPadding;
+  m_cfg.meshletMergeParts   = header->meshletMergeParts != 0;
+  m_cfg.meshletLod          = header->meshletLod != 0;
+  m_cfg.meshletStrips       = header->meshletStrips != 0;
+  m_cfg.optimizeVertexOrder = header->optimizeVertexOrder != 0;
+  m_cfg.weldVertices        = header->weldVertices != 0;
+  m_cfg.weldEpsilon         = header->weldEpsilon;
+  m_cfg.scale               = header->scale;
+
+  const Material*          materials     = (const Material*)(data + header->materialsOffset);
+  const MatrixNode*        matrices      = (const MatrixNode*)(data + header->matricesOffset);
+  const BBox*              bboxes        = (const BBox*)(data + header->bboxesOffset);
+  const BakedObject*       objects       = (const BakedObject*)(data + header->objectsOffset);
+  const ObjectPart*        objectParts   = (const ObjectPart*)(data + header->objectPartsOffset);
+  const BakedGeometryPart* geometryParts = (const BakedGeometryPart*)(data + header->geometryPartsOffset);
+  const BakedGeometry*     geometries    = (const BakedGeometry*)(header + 1);
+
+  m_materials.assign(materials, materials + header->numMaterials);
+  m_matrices.assign(matrices, matrices + header->numMatrices);
+  m_bboxes.assign(bboxes, bboxes + header->numBboxes);
+  m_geometry.resize(header->numGeometries);
+
+  if(m_progress)
+  {
+    m_progress->numGeometries = header->numGeometries;
+  }
+
+  m_objects.resize(header->numObjects);
+  uint32_t objectPartOffset = 0;
+  for(uint32_t o = 0; o < header->numObjects; o++)
+  {
+    const BakedObject& entry  = objects[o];
+    Object&            object = m_objects[o];
+
+    // the renderers walk the object's parts alongside its geometry's parts
+    if(entry.numParts > header->numObjectParts - objectPartOffset || entry.partOffset != int32_t(objectPartOffset)
+       || uint32_t(entry.geometryIndex) >= header->numGeometries || uint32_t(entry.matrixIndex) >= header->numMatrices
+       || !entry.numParts || entry.numParts != geometries[entry.geometryIndex].numParts)
+    {
+      LOGE("baked scene: %s object %d out of range\n", filename, o)
+      unload();
+      return false;
+    }
+
+    for(uint32_t p = 0; p < entry.numParts; p++)
+    {
+      const ObjectPart& part = objectParts[objectPartOffset + p];
+      if(uint32_t(part.matrixIndex) >= header->numMatrices || uint32_t(part.materialIndex) >= header->numMaterials)
       {
-        m_meshSize += geom.meshSize + geom.meshIndicesSize;
-        groups += numMeshlets;
-        meshActualSizeTotal += meshActualSize;
+        LOGE("baked scene: %s object %d part %d out of range\n", filename, o, p)
+        unload();
+        return false;
       }
     }
+
+    object.partOffset    = entry.partOffset;
+    object.matrixIndex   = entry.matrixIndex;
+    object.geometryIndex = entry.geometryIndex;
+    object.faceCCW       = entry.faceCCW;
+    object.parts.assign(objectParts + objectPartOffset, objectParts + objectPartOffset + entry.numParts);
+    objectPartOffset += entry.numParts;
   }
 
-  LOGI("meshlet config: %d vertices, %d primitives\n", m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount)
+  m_vboSize          = 0;
+  m_iboSize          = 0;
+  m_meshSize         = 0;
+  m_meshletErrors    = 0;
+  m_numObjectParts   = header->numObjectParts;
+  m_numGeometryParts = header->numGeometryParts;
 
-  if(m_cfg.verbose)
+  for(uint32_t g = 0; g < header->numGeometries; g++)
   {
-    statsGlobal.fprint(stdout);
-  }
+    const BakedGeometry& entry = geometries[g];
+    Geometry&            geom  = m_geometry[g];
+
+    geom.mappedData = true;
+
+    if(!isInFile(entry.vboOffset, entry.vboSize) || !isInFile(entry.aboOffset, entry.aboSize)
+       || !isInFile(entry.iboOffset, entry.iboSize) || !isInFile(entry.descOffset, entry.descSize)
+       || !isInFile(entry.primOffset, entry.primSize) || entry.vboSize != getVertexSize() * entry.numVertices
+       || entry.aboSize != getVertexAttributeSize() * entry.numVertices
+       || entry.iboSize != (entry.useShorts ? sizeof(uint16_t) : sizeof(uint32_t)) * entry.numIndexSolid
+       || entry.descSize != sizeof(NVMeshlet::MeshletPackBasicDesc) * uint64_t(entry.numMeshlets)
+       || entry.numParts > header->numGeometryParts - std::min(entry.partOffset, header->numGeometryParts)
+       || entry.numParts > header->numBboxes - std::min(entry.partBboxOffset, header->numBboxes) || !entry.numParts)
+    {
+      LOGE("baked scene: %s geometry %d out of range\n", filename, g)
+      unload();
+      return false;
+    }
 
-  LOGI("meshlet total: %9d meshlets, %7d KB (w %.2f)\n", groups, m_meshSize / 1024,
-       (double(m_meshSize) / double(meshActualSizeTotal) - 1.0))
+    uint64_t indexSize = entry.useShorts ? sizeof(uint16_t) : sizeof(uint32_t);
+    for(uint32_t p = 0; p < entry.numParts; p++)
+    {
+      const BakedGeometryPart& part = geometryParts[entry.partOffset + p];
+      if(part.indexOffset % indexSize || part.indexOffset / indexSize + part.indexCount > entry.numIndexSolid
+         || uint64_t(part.meshSolid.offset) + part.meshSolid.count > entry.numMeshlets
+         || uint64_t(part.meshLod.offset) + part.meshLod.count > entry.numMeshlets)
+      {
+        LOGE("baked scene: %s geometry %d part %d out of range\n", filename, g, p)
+        unload();
+        return false;
+      }
+    }
+
+    geom.partOffset     = int(entry.partOffset);
+    geom.partBboxOffset = int(entry.partBboxOffset);
+    geom.useShorts      = int(entry.useShorts);
+    geom.numVertices    = int(entry.numVertices);
+    geom.numIndexSolid  = int(entry.numIndexSolid);
+
+    geom.vboSize = entry.vboSize;
+    geom.aboSize = entry.aboSize;
+    geom.iboSize = entry.iboSize;
+    geom.vboData = (void*)(data + entry.vboOffset);
+    geom.aboData = (void*)(data + entry.aboOffset);
+    geom.iboData = (void*)(data + entry.iboOffset);
+
+    geom.meshlet.numMeshlets = int(entry.numMeshlets);
+    geom.meshlet.descSize    = entry.descSize;
+    geom.meshlet.primSize    = entry.primSize;
+    geom.meshlet.descMapped  = (const NVMeshlet::MeshletPackBasicDesc*)(data + entry.descOffset);
+    geom.meshlet.primMapped  = (const NVMeshlet::PackBasicType*)(data + entry.primOffset);
+    geom.meshSize            = entry.numMeshlets ? entry.descSize : 0;
+    geom.meshIndicesSize     = entry.numMeshlets ? entry.primSize : 0;
+
+    geom.parts.resize(entry.numParts);
+    for(uint32_t p = 0; p < entry.numParts; p++)
+    {
+      const BakedGeometryPart& part = geometryParts[entry.partOffset + p];
+      geom.parts[p].indexSolid.offset = size_t(part.indexOffset);
+      geom.parts[p].indexSolid.count  = int(part.indexCount);
+      geom.parts[p].meshSolid         = part.meshSolid;
+      geom.parts[p].meshLod           = part.meshLod;
+    }
+
+    m_vboSize += geom.vboSize + geom.aboSize;
+    m_iboSize += geom.iboSize;
+    m_meshSize += geom.meshSize + geom.meshIndicesSize;
+
+    if(m_progress)
+    {
+      m_progress->geometries++;
+    }
+  }
+
+  m_bakedMapping = mapping;
+
+  memcpy(m_bbox.min.vec_array, header->bboxMin, sizeof(header->bboxMin));
+  memcpy(m_bbox.max.vec_array, header->bboxMax, sizeof(header->bboxMax));
+
+  setupCopies(clones, cloneaxis, header->rootIDX);
+
+  return true;
+}
+
+bool CadScene::saveMeshletStats(const char* filename) const
+{
+  NVMeshlet::PackBasicBuilder meshletBuilder{};
+  meshletBuilder.setup(m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, false, m_cfg.meshEncoding == NVMESHLET_ENCODING_PACKDELTA);
+
+  std::vector<NVMeshlet::Stats> geometryStats(m_geometry.size());
+  NVMeshlet::Stats              stats;
+  NVMeshlet::StatsHistograms    histograms;
+
+#pragma omp parallel
+  {
+    NVMeshlet::StatsHistograms histogramsLocal;
+
+#pragma omp for
+    for(int g = 0; g < int(m_geometry.size()); g++)
+    {
+      const Geometry& geom = m_geometry[g];
+      if(!geom.meshlet.numMeshlets)
+      {
+        continue;
+      }
+
+      // lod hierarchies are appended after the regular meshlets
+      size_t numMeshlets = geom.parts[0].meshLod.count ? geom.parts[0].meshLod.offset : size_t(geom.meshlet.numMeshlets);
+
+      NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometry;
+      meshletGeometry.meshletDescriptors.assign(geom.meshlet.getDescData(), geom.meshlet.getDescData() + numMeshlets);
+      meshletGeometry.meshletPacks.assign(geom.meshlet.getPrimData(),
+                                          geom.meshlet.getPrimData() + geom.meshlet.primSize / sizeof(NVMeshlet::PackBasicType));
+      meshletGeometry.positionLatticeBits = m_cfg.meshPositionBits;
+
+      meshletBuilder.appendStats(meshletGeometry, geometryStats[g]);
+      meshletBuilder.appendHistograms(meshletGeometry, histogramsLocal);
+    }
+
+#pragma omp critical
+    {
+      histograms.append(histogramsLocal);
+    }
+  }
+
+  for(const NVMeshlet::Stats& statsLocal : geometryStats)
+  {
+    stats.append(statsLocal);
+  }
+
+  FILE* file = fopen(filename, "w");
+  if(!file)
+  {
+    return false;
+  }
+
+  // trailing empty buckets are left out
+  auto printHistogram = [&](const char* name, const size_t* buckets, size_t numBuckets, const char* separator) {
+    while(numBuckets && !buckets[numBuckets - 1])
+    {
+      numBuckets--;
+    }
+    fprintf(file, "    \"%s\": [", name);
+    for(size_t i = 0; i < numBuckets; i++)
+    {
+      fprintf(file, i ? ", %zu" : "%zu", buckets[i]);
+    }
+    fprintf(file, "]%s\n", separator);
+  };
+
+  fprintf(file, "{\n");
+  fprintf(file, "  \"config\": {\"vertices\": %d, \"primitives\": %d, \"builder\": %d, \"encoding\": %d, \"positionBits\": %d, \"strips\": %s},\n",
+          m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, m_cfg.meshBuilder, m_cfg.meshEncoding, m_cfg.meshPositionBits,
+          m_cfg.meshletStrips ? "true" : "false");
+  fprintf(file, "  \"total\": ");
+  stats.fprintJson(file);
+  fprintf(file, ",\n");
+
+  // cones are offset by 128, see NVMeshlet::StatsHistograms
+  fprintf(file, "  \"histograms\": {\n");
+  printHistogram("vertices", histograms.vertices, sizeof(histograms.vertices) / sizeof(histograms.vertices[0]), ",");
+  printHistogram("primitives", histograms.primitives, sizeof(histograms.primitives) / sizeof(histograms.primitives[0]), ",");
+  printHistogram("cones", histograms.cones, 256, ",");
+  printHistogram("bboxExtents", histograms.bboxExtents, 256, "");
+  fprintf(file, "  },\n");
+
+  fprintf(file, "  \"geometries\": [\n");
+  for(size_t g = 0; g < m_geometry.size(); g++)
+  {
+    fprintf(file, "    {\"geometry\": %zu, \"triangles\": %d, \"stats\": ", g, m_geometry[g].numIndexSolid / 3);
+    geometryStats[g].fprintJson(file);
+    fprintf(file, "}%s\n", g + 1 < m_geometry.size() ? "," : "");
+  }
+  fprintf(file, "  ]\n");
+  fprintf(file, "}\n");
+
+  bool success = ferror(file) == 0;
+  fclose(file);
+
+  return success;
+}
+
+// Reports the triangles of the lod cuts when every geometry is viewed from
+// multiples of its bbox diagonal, with one pixel error at 1080p and 45 degrees fov.
+static void printMeshletLodCuts(const std::vector<CadScene::Geometry>& geometries, const std::vector<CadScene::BBox>& bboxes, bool hasPositions)
+{
+  const float errorScale  = 1080.0f / (2.0f * tanf(45.0f * 0.5f * nvmath::nv_pi / 180.0f));
+  const float distances[] = {1.0f, 4.0f, 16.0f, 64.0f};
+
+  size_t                triangles[4]  = {};
+  size_t                trianglesFull = 0;
+  std::vector<uint32_t> selected;
+
+  for(size_t g = 0; g < geometries.size(); g++)
+  {
+    const CadScene::Geometry& geom = geometries[g];
+    const CadScene::BBox&     bbox = bboxes[g];
+    if(!geom.meshlet.numMeshlets)
+    {
+      continue;
+    }
+
+    nvmath::vec3f center   = nvmath::vec3f(bbox.min + bbox.max) * 0.5f;
+    float         diagonal = nvmath::length(nvmath::vec3f(bbox.max - bbox.min));
+
+    for(const CadScene::GeometryPart& part : geom.parts)
+    {
+      trianglesFull += part.indexSolid.count / 3;
+      for(size_t d = 0; d < 4; d++)
+      {
+        nvmath::vec3f viewPos = center + nvmath::vec3f(0, 0, diagonal * distances[d]);
+        triangles[d] += NVMeshlet::selectMeshletLodCut(geom.meshlet.getDescData(), geom.meshlet.getPrimData(), part.meshLod.offset,
+                                                       part.meshLod.offset + part.meshLod.count, hasPositions,
+                                                       viewPos.vec_array, errorScale, selected);
+        selected.clear();
+      }
+    }
+  }
+
+  LOGI("meshlet lod: triangles %zu, cut at 1/4/16/64 x bbox diagonal: %zu %zu %zu %zu\n", trianglesFull, triangles[0],
+       triangles[1], triangles[2], triangles[3])
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void CadScene::buildMeshletTopology(const CSFile* csf, const char* cacheFilename)
+{
+  NVMeshlet::Stats statsGlobal;
+  NVMeshlet::Stats statsReference;
+  uint32_t         groups              = 0;
+  size_t           meshActualSizeTotal = 0;
+
+// triangles per concurrently built chunk, large enough that the
+// partially filled meshlets at chunk boundaries are negligible
+#define MESHLET_CHUNK_TRIANGLES (64 * 1024)
+
+  if(m_cfg.meshBuilder == MESHLET_BUILDER_PACKBASIC || m_cfg.meshBuilder == MESHLET_BUILDER_SPATIAL)
+  {
+    NVMeshlet::PackBasicBuilder meshletBuilder{};
+    meshletBuilder.setup(m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, false,
+                         m_cfg.meshEncoding == NVMESHLET_ENCODING_PACKDELTA);
+
+    // geometries whose input and config match the cache skip building
+    std::vector<uint64_t> geometryHashes;
+    std::vector<uint8_t>  geometryCached(csf->numGeometries, 0);
+    uint32_t              cachedGeometries = 0;
+    if(cacheFilename)
+    {
+      geometryHashes.resize(csf->numGeometries);
+#pragma omp parallel for
+      for(int g = 0; g < csf->numGeometries; g++)
+      {
+        geometryHashes[g] = hashMeshletInput(csf->geometries + g, m_cfg);
+      }
+
+      cachedGeometries = loadMeshletCache(cacheFilename, geometryHashes, geometryCached);
+      LOGI("meshlet cache: %d of %d geometries loaded from %s\n", cachedGeometries, csf->numGeometries, cacheFilename)
+    }
+
+    // Parts are split into chunks of triangles that are built concurrently,
+    // so that a single huge geometry does not serialize the build.
+    // The chunks of a geometry are stitched together in order afterwards.
+    struct MeshletTask
+    {
+      uint32_t geometry;
+      uint32_t part;
+      uint32_t chunk;
+      uint32_t indexOffset;
+      uint32_t numIndex;
+    };
+
+    const uint32_t chunkIndices = MESHLET_CHUNK_TRIANGLES * 3;
+
+    // all parts of a geometry are built as one, the meshlets' part ranges
+    // are stored after building
+    const bool mergeParts = m_cfg.meshletMergeParts && m_cfg.meshBuilder == MESHLET_BUILDER_PACKBASIC;
+    if(m_cfg.meshletMergeParts && !mergeParts)
+    {
+      LOGI("meshlet merged parts: requires index order builder, ignored\n")
+    }
+
+    // every part additionally gets its lod hierarchy, appended after all parts
+    const bool buildLods = m_cfg.meshletLod && !mergeParts;
+    if(m_cfg.meshletLod && !buildLods)
+    {
+      LOGI("meshlet lod: not supported with merged parts, ignored\n")
+    }
+    NVMeshlet::LodConfig lodConfig;
+    NVMeshlet::LodStats  lodStats;
+
+    // strips reorder the primitives within meshlets, which the part ranges rely on
+    const bool buildStrips = m_cfg.meshletStrips && !mergeParts;
+    if(m_cfg.meshletStrips && !buildStrips)
+    {
+      LOGI("meshlet strips: not supported with merged parts, ignored\n")
+    }
+
+    std::vector<MeshletTask> tasks;
+    std::vector<size_t>      geometryTasks(csf->numGeometries + 1);
+    for(int g = 0; g < csf->numGeometries; g++)
+    {
+      const CSFGeometry* csfgeom     = csf->geometries + g;
+      uint32_t           indexOffset = 0;
+
+      geometryTasks[g] = tasks.size();
+      if(geometryCached[g])
+      {
+        continue;
+      }
+
+      int numTaskParts = mergeParts ? 1 : csfgeom->numParts;
+      for(int p = 0; p < numTaskParts; p++)
+      {
+        uint32_t numIndex = mergeParts ? uint32_t(csfgeom->numIndexSolid) : csfgeom->parts[p].numIndexSolid;
+        uint32_t chunk    = 0;
+        do
+        {
+          uint32_t numChunkIndex = std::min(numIndex - chunk * chunkIndices, chunkIndices);
+          tasks.push_back({uint32_t(g), uint32_t(p), chunk, indexOffset + chunk * chunkIndices, numChunkIndex});
+          chunk++;
+        } while(chunk * chunkIndices < numIndex);
+
+        indexOffset += numIndex;
+      }
+    }
+    geometryTasks[csf->numGeometries] = tasks.size();
+
+    if(m_progress)
+    {
+      m_progress->numMeshletSteps = uint32_t(tasks.size()) + uint32_t(csf->numGeometries);
+    }
+
+    std::vector<NVMeshlet::PackBasicBuilder::MeshletGeometry> taskGeometries(tasks.size());
+
+    // the hot build loop uses a builder whose scratch arrays are sized for the configured limits
+    NVMeshlet::dispatchPackBasicBuilder(m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, [&](auto& taskBuilder) {
+      taskBuilder.setup(m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount, false,
+                        m_cfg.meshEncoding == NVMESHLET_ENCODING_PACKDELTA);
+
+#pragma omp parallel for schedule(dynamic)
+      for(int t = 0; t < int(tasks.size()); t++)
+      {
+        const MeshletTask& task    = tasks[t];
+        const CSFGeometry* csfgeom = csf->geometries + task.geometry;
+        const BBox&        bbox    = m_bboxes[task.geometry];
+
+        NVMeshlet::PackBasicBuilder::MeshletGeometry& meshletGeometry = taskGeometries[t];
+
+        if(m_progress)
+        {
+          m_progress->meshletSteps++;
+        }
+
+        if(!task.numIndex)
+        {
+          continue;
+        }
+
+        const unsigned int* indices = csfgeom->indexSolid + task.indexOffset;
+
+        taskBuilder.reserveMeshlets(meshletGeometry, task.numIndex, uint32_t(csfgeom->numVertices - 1));
+
+        uint32_t processedIndices =
+            m_cfg.meshBuilder == MESHLET_BUILDER_SPATIAL ?
+                taskBuilder.template buildMeshletsSpatial<uint32_t>(meshletGeometry, task.numIndex, indices,
+                                                                    (const float*)csfgeom->vertex, sizeof(float) * 3) :
+                taskBuilder.template buildMeshlets<uint32_t>(meshletGeometry, task.numIndex, indices);
+        if(processedIndices != task.numIndex)
+        {
+          LOGE("warning: geometry meshlet incomplete %d\n", task.geometry)
+        }
+
+        taskBuilder.buildMeshletEarlyCulling(meshletGeometry, bbox.min.vec_array, bbox.max.vec_array,
+                                             (const float*)csfgeom->vertex, sizeof(float) * 3);
+        if(buildStrips)
+        {
+          taskBuilder.buildMeshletStrips(meshletGeometry);
+        }
+        if(m_cfg.meshPositionBits)
+        {
+          taskBuilder.buildMeshletPositions(meshletGeometry, bbox.min.vec_array, bbox.max.vec_array,
+                                            (const float*)csfgeom->vertex, sizeof(float) * 3, m_cfg.meshPositionBits);
+        }
+        if(mergeParts)
+        {
+          std::vector<uint32_t> triangleParts(task.numIndex / 3);
+
+          uint32_t part      = 0;
+          uint32_t partBegin = 0;
+          for(uint32_t tri = 0; tri < uint32_t(triangleParts.size()); tri++)
+          {
+            uint32_t index = task.indexOffset + tri * 3;
+            while(index >= partBegin + csfgeom->parts[part].numIndexSolid)
+            {
+              partBegin += csfgeom->parts[part].numIndexSolid;
+              part++;
+            }
+            triangleParts[tri] = part;
+          }
+
+          taskBuilder.buildMeshletParts(meshletGeometry, task.numIndex, indices, triangleParts.data());
+        }
+
+        // mapped source, later passes map the pages again as needed
+        if(!m_sourceCopies.empty() && m_sourceCopies[task.geometry].empty())
+        {
+          releaseMappedPages(indices, sizeof(uint32_t) * task.numIndex);
+          if(geometryTasks[task.geometry + 1] - geometryTasks[task.geometry] == 1)
+          {
+            releaseMappedPages(csfgeom->vertex, sizeof(float) * 3 * csfgeom->numVertices);
+          }
+        }
+      }
+    });
+
+#pragma omp parallel for
+    for(int g = 0; g < csf->numGeometries; g++)
+    {
+      const CSFGeometry* csfgeom = csf->geometries + g;
+      Geometry&          geom    = m_geometry[g];
+
+      if(m_progress)
+      {
+        m_progress->meshletSteps++;
+      }
+
+      if(geometryCached[g])
+      {
+        releaseGeometrySource(csfgeom, g);
+        continue;
+      }
+
+      NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometry;
+
+      // reserved exactly, the stitched output ends up in the topology as is
+      size_t numPacks       = 0;
+      size_t numDescriptors = 0;
+      for(size_t t = geometryTasks[g]; t < geometryTasks[g + 1]; t++)
+      {
+        numPacks += taskGeometries[t].meshletPacks.size();
+        numDescriptors += taskGeometries[t].meshletDescriptors.size() + m_cfg.meshTaskPadding;
+      }
+      meshletGeometry.meshletPacks.reserve(numPacks);
+      meshletGeometry.meshletDescriptors.reserve(numDescriptors);
+
+      uint32_t numMeshlets = 0;
+      for(size_t t = geometryTasks[g]; t < geometryTasks[g + 1]; t++)
+      {
+        const MeshletTask& task = tasks[t];
+        GeometryPart&      part = geom.parts[task.part];
+
+        if(task.chunk == 0)
+        {
+          // parts start at task workgroup boundaries
+          NVMeshlet::PackBasicBuilder::padTaskMeshlets(meshletGeometry, m_cfg.meshTaskPadding);
+          numMeshlets = (uint32_t)meshletGeometry.meshletDescriptors.size();
+
+          part.meshSolid.offset = numMeshlets;
+          part.meshSolid.count  = 0;
+        }
+
+        NVMeshlet::PackBasicBuilder::appendGeometry(meshletGeometry, taskGeometries[t]);
+        taskGeometries[t] = {};
+
+        part.meshSolid.count += (uint32_t)meshletGeometry.meshletDescriptors.size() - numMeshlets;
+        numMeshlets           = (uint32_t)meshletGeometry.meshletDescriptors.size();
+      }
+
+      if(mergeParts)
+      {
+        // part ranges overlap where meshlets are shared
+        for(GeometryPart& part : geom.parts)
+        {
+          part.meshSolid = {};
+        }
+        for(size_t m = 0; m < meshletGeometry.meshletDescriptors.size(); m++)
+        {
+          uint32_t partFirst;
+          uint32_t partLast;
+          NVMeshlet::PackBasicBuilder::getMeshletParts(meshletGeometry, m, partFirst, partLast);
+          for(uint32_t p = partFirst; p <= partLast; p++)
+          {
+            MeshletRange& range = geom.parts[p].meshSolid;
+            if(!range.count)
+            {
+              range.offset = uint32_t(m);
+            }
+            range.count = uint32_t(m) - range.offset + 1;
+          }
+        }
+        // empty parts start where the previous one ends
+        for(size_t p = 1; p < geom.parts.size(); p++)
+        {
+          MeshletRange& range = geom.parts[p].meshSolid;
+          if(!range.count)
+          {
+            range.offset = geom.parts[p - 1].meshSolid.offset + geom.parts[p - 1].meshSolid.count;
+          }
+        }
+      }
+
+      geom.meshlet.numMeshlets = int(meshletGeometry.meshletDescriptors.size());
+
+      if(m_cfg.meshletErrorCheck)
+      {
+        NVMeshlet::StatusCode errorcode =
+            m_cfg.meshBuilder == MESHLET_BUILDER_SPATIAL || buildStrips ?
+                meshletBuilder.errorCheckUnordered<uint32_t>(meshletGeometry, 0, csfgeom->numVertices - 1,
+                                                             csfgeom->numIndexSolid, csfgeom->indexSolid) :
+                meshletBuilder.errorCheck<uint32_t>(meshletGeometry, 0, csfgeom->numVertices - 1, csfgeom->numIndexSolid,
+                                                    csfgeom->indexSolid);
+        if(errorcode)
+        {
+          LOGE("geometry %d: meshlet error %d\n", g, errorcode)
+#pragma omp atomic
+          m_meshletErrors++;
+        }
+      }
+
+      if(m_cfg.verbose)
+      {
+        NVMeshlet::Stats statsLocal;
+        meshletBuilder.appendStats(meshletGeometry, statsLocal);
+
+        // compare against meshlets in index order
+        NVMeshlet::Stats statsLocalReference;
+        if(m_cfg.meshBuilder != MESHLET_BUILDER_PACKBASIC)
+        {
+          NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometryReference;
+
+          uint32_t indexOffsetReference = 0;
+          for(size_t p = 0; p < geom.parts.size(); p++)
+          {
+            meshletBuilder.buildMeshlets<uint32_t>(meshletGeometryReference, csfgeom->parts[p].numIndexSolid,
+                                                   csfgeom->indexSolid + indexOffsetReference);
+            indexOffsetReference += csfgeom->parts[p].numIndexSolid;
+          }
+          meshletBuilder.buildMeshletEarlyCulling(meshletGeometryReference, m_bboxes[g].min.vec_array,
+                                                  m_bboxes[g].max.vec_array, (const float*)csfgeom->vertex, sizeof(float) * 3);
+          meshletBuilder.appendStats(meshletGeometryReference, statsLocalReference);
+        }
+
+#pragma omp critical
+        {
+          statsGlobal.append(statsLocal);
+          statsReference.append(statsLocalReference);
+        }
+      }
+
+      if(buildLods)
+      {
+        NVMeshlet::LodStats lodStatsLocal;
+
+        uint32_t indexOffset = 0;
+        for(size_t p = 0; p < geom.parts.size(); p++)
+        {
+          GeometryPart& part     = geom.parts[p];
+          uint32_t      numIndex = csfgeom->parts[p].numIndexSolid;
+
+          NVMeshlet::PackBasicBuilder::MeshletGeometry lodGeometry;
+          std::vector<NVMeshlet::MeshletLod>           lods;
+          if(numIndex)
+          {
+            NVMeshlet::buildMeshletLodHierarchy(meshletBuilder, lodGeometry, lods, numIndex, csfgeom->indexSolid + indexOffset,
+                                                (const float*)csfgeom->vertex, sizeof(float) * 3, lodConfig, &lodStatsLocal);
+            meshletBuilder.buildMeshletEarlyCulling(lodGeometry, m_bboxes[g].min.vec_array, m_bboxes[g].max.vec_array,
+                                                    (const float*)csfgeom->vertex, sizeof(float) * 3);
+            if(buildStrips)
+            {
+              meshletBuilder.buildMeshletStrips(lodGeometry);
+            }
+            if(m_cfg.meshPositionBits)
+            {
+              meshletBuilder.buildMeshletPositions(lodGeometry, m_bboxes[g].min.vec_array, m_bboxes[g].max.vec_array,
+                                                   (const float*)csfgeom->vertex, sizeof(float) * 3, m_cfg.meshPositionBits);
+            }
+            meshletBuilder.appendMeshletLods(lodGeometry, lods.data());
+          }
+          indexOffset += numIndex;
+
+          NVMeshlet::PackBasicBuilder::padTaskMeshlets(meshletGeometry, m_cfg.meshTaskPadding);
+
+          part.meshLod.offset = uint32_t(meshletGeometry.meshletDescriptors.size());
+          part.meshLod.count  = uint32_t(lodGeometry.meshletDescriptors.size());
+
+          NVMeshlet::PackBasicBuilder::appendGeometry(meshletGeometry, lodGeometry);
+        }
+        geom.meshlet.numMeshlets = int(meshletGeometry.meshletDescriptors.size());
+
+#pragma omp critical
+        {
+          lodStats.numHierarchies += lodStatsLocal.numHierarchies;
+          lodStats.numLevels += lodStatsLocal.numLevels;
+          lodStats.numMeshlets += lodStatsLocal.numMeshlets;
+          lodStats.numRoots += lodStatsLocal.numRoots;
+        }
+      }
+
+      fillMeshletTopology(meshletGeometry, geom.meshlet, geom.useShorts);
+
+      releaseGeometrySource(csfgeom, g);
+    }
+
+    for(int g = 0; g < csf->numGeometries; g++)
+    {
+      Geometry& geom = m_geometry[g];
+
+      if(!geom.meshlet.numMeshlets)
+      {
+        continue;
+      }
+
+      geom.meshSize        = geom.meshlet.descSize;
+      geom.meshIndicesSize = geom.meshlet.primSize;
+
+      m_meshSize += geom.meshSize + geom.meshIndicesSize;
+      groups += geom.meshlet.numMeshlets;
+      meshActualSizeTotal += geom.meshlet.descSize + geom.meshlet.primSize;
+    }
+
+    if(buildLods && lodStats.numMeshlets)
+    {
+      LOGI("meshlet lod: %d meshlets (%d roots), %.1f levels per part\n", lodStats.numMeshlets, lodStats.numRoots,
+           double(lodStats.numLevels) / double(lodStats.numHierarchies))
+      if(m_cfg.verbose)
+      {
+        printMeshletLodCuts(m_geometry, m_bboxes, m_cfg.meshPositionBits != 0);
+      }
+    }
+
+    if(cacheFilename && cachedGeometries < uint32_t(csf->numGeometries))
+    {
+      if(!saveMeshletCache(cacheFilename, geometryHashes))
+      {
+        LOGE("meshlet cache: could not write %s\n", cacheFilename)
+      }
+    }
+  }
+
+  LOGI("meshlet config: %d vertices, %d primitives\n", m_cfg.meshVertexCount, m_cfg.meshPrimitiveCount)
+
+  if(m_cfg.verbose)
+  {
+    statsGlobal.fprint(stdout, m_cfg.meshBuilder != MESHLET_BUILDER_PACKBASIC ? &statsReference : nullptr);
+  }
+
+  LOGI("meshlet total: %9d meshlets, %7d KB (w %.2f)\n", groups, m_meshSize / 1024,
+       (double(m_meshSize) / double(meshActualSizeTotal) - 1.0))
+}
+
+static double getTimeMilliseconds()
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool CadScene::benchmarkHalfConversion(uint32_t numVertices)
+{
+  // magnitudes from denormal to overflow, plus a sweep over the float bit patterns
+  std::vector<float>                    input(size_t(numVertices) * 3);
+  std::mt19937                          rng(1);
+  std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+  const float                           scales[] = {1.0e-6f, 1.0f, 100.0f, 1.0e5f};
+  for(size_t i = 0; i < input.size(); i++)
+  {
+    input[i] = value(rng) * scales[rng() % 4];
+  }
+  for(size_t i = 0; i < input.size() / 2; i++)
+  {
+    uint32_t bits = uint32_t(i * 257);
+    memcpy(&input[i * 2], &bits, sizeof(bits));
+  }
+
+  std::vector<half>  outputVertex(size_t(numVertices) * 4);
+  std::vector<half>  outputBatch(size_t(numVertices) * 4);
+  std::vector<float> outputCopy(size_t(numVertices) * 3);
+
+  double timeVertex = DBL_MAX;
+  double timeBatch  = DBL_MAX;
+  double timeCopy   = DBL_MAX;
+
+  const int runs = 5;
+  for(int r = 0; r < runs; r++)
+  {
+    // previous per vertex conversion
+    double timeBegin = getTimeMilliseconds();
+    for(uint32_t i = 0; i < numVertices; i++)
+    {
+      floatToHalfVector(&outputVertex[i * 4], nvmath::vec4f(input[i * 3 + 0], input[i * 3 + 1], input[i * 3 + 2], 1.0f));
+    }
+    timeVertex = std::min(timeVertex, getTimeMilliseconds() - timeBegin);
+
+    timeBegin = getTimeMilliseconds();
+    floatToHalfVectors(outputBatch.data(), 4, input.data(), numVertices, 1.0f);
+    timeBatch = std::min(timeBatch, getTimeMilliseconds() - timeBegin);
+
+    // memory bandwidth reference
+    timeBegin = getTimeMilliseconds();
+    memcpy(outputCopy.data(), input.data(), sizeof(float) * input.size());
+    timeCopy = std::min(timeCopy, getTimeMilliseconds() - timeBegin);
+  }
+
+  size_t mismatches = 0;
+  for(size_t i = 0; i < outputBatch.size(); i++)
+  {
+    mismatches += outputVertex[i] != outputBatch[i] ? 1 : 0;
+  }
+
+  double bytes = double(numVertices) * (sizeof(float) * 3 + sizeof(half) * 4);
+
+  LOGI("half conversion benchmark: %d vertices, best of %d runs, %s\n", numVertices, runs,
+       useF16C() ? "F16C" : (CADSCENE_F16C ? "scalar, cpu lacks F16C" : "scalar, not x86"))
+  LOGI("  per vertex: %9.2f ms, %6.2f GB/s\n", timeVertex, bytes / (timeVertex * 1.0e6))
+  LOGI("  batch:      %9.2f ms, %6.2f GB/s\n", timeBatch, bytes / (timeBatch * 1.0e6))
+  LOGI("  memcpy:     %9.2f ms, %6.2f GB/s\n", timeCopy, double(sizeof(float) * 3 * 2) * numVertices / (timeCopy * 1.0e6))
+  LOGI("  mismatches: %9zu\n", mismatches)
+
+  return mismatches == 0;
+}
+
+bool CadScene::benchmarkMeshletBuilder(const char* filename, const LoadConfig& cfg)
+{
+  CSFile*         csf;
+  CSFileMemoryPTR csfmem = CSFileMemory_new();
+
+  if(CSFile_loadExt(&csf, filename, csfmem) != CADSCENEFILE_NOERROR)
+  {
+    CSFileMemory_delete(csfmem);
+    return false;
+  }
+
+  // bboxes only matter for the quantization of the meshlet bboxes
+  std::vector<BBox> bboxes(csf->numGeometries);
+  for(int g = 0; g < csf->numGeometries; g++)
+  {
+    const CSFGeometry* csfgeom = &csf->geometries[g];
+    for(int i = 0; i < csfgeom->numVertices; i++)
+    {
+      bboxes[g].merge(nvmath::vec4f(csfgeom->vertex[i * 3 + 0], csfgeom->vertex[i * 3 + 1], csfgeom->vertex[i * 3 + 2], 1.0f));
+    }
+  }
+
+  // common limits plus the configured one
+  std::vector<std::pair<uint32_t, uint32_t>> limits = {{64, 84}, {64, 126}, {128, 256}};
+  std::pair<uint32_t, uint32_t>              limitConfig(cfg.meshVertexCount, cfg.meshPrimitiveCount);
+  if(std::find(limits.begin(), limits.end(), limitConfig) == limits.end())
+  {
+    limits.push_back(limitConfig);
+  }
+
+  const int runs = 3;
+
+  LOGI("meshlet builder benchmark: %s (%d geometries, best of %d runs)\n", filename, csf->numGeometries, runs)
+
+  for(const auto& limit : limits)
+  {
+    NVMeshlet::PackBasicBuilder meshletBuilder{};
+    meshletBuilder.setup(limit.first, limit.second, false, cfg.meshEncoding == NVMESHLET_ENCODING_PACKDELTA);
+
+    double timeBuild         = DBL_MAX;
+    double timeBuildSimd     = DBL_MAX;
+    double timeBuildSpatial  = DBL_MAX;
+    double timeBuildFixed    = DBL_MAX;
+    double timeCulling       = DBL_MAX;
+    double timeCullingScalar = DBL_MAX;
+    bool   cullingIdentical  = true;
+    bool   fixedIdentical    = true;
+    size_t numMeshlets       = 0;
+
+    for(int r = 0; r < runs; r++)
+    {
+      std::vector<NVMeshlet::PackBasicBuilder::MeshletGeometry> meshletGeometries(csf->numGeometries);
+
+      // vertex lookup with SIMD compares instead of the default hash, output is identical
+      {
+        std::vector<NVMeshlet::PackBasicBuilder::MeshletGeometry> meshletGeometriesSimd(csf->numGeometries);
+
+        double timeBegin = getTimeMilliseconds();
+
+#pragma omp parallel for
+        for(int g = 0; g < csf->numGeometries; g++)
+        {
+          const CSFGeometry* csfgeom     = &csf->geometries[g];
+          uint32_t           indexOffset = 0;
+          for(int p = 0; p < csfgeom->numParts; p++)
+          {
+            uint32_t numIndex = csfgeom->parts[p].numIndexSolid;
+            meshletBuilder.buildMeshlets<uint32_t, NVMeshlet::PRIMITIVE_CACHE_LOOKUP_SIMD>(
+                meshletGeometriesSimd[g], numIndex, csfgeom->indexSolid + indexOffset);
+            indexOffset += numIndex;
+          }
+        }
+
+        timeBuildSimd = std::min(timeBuildSimd, getTimeMilliseconds() - timeBegin);
+      }
+
+      // meshlets grown over triangle adjacency
+      {
+        std::vector<NVMeshlet::PackBasicBuilder::MeshletGeometry> meshletGeometriesSpatial(csf->numGeometries);
+
+        double timeBegin = getTimeMilliseconds();
+
+#pragma omp parallel for
+        for(int g = 0; g < csf->numGeometries; g++)
+        {
+          const CSFGeometry* csfgeom     = &csf->geometries[g];
+          uint32_t           indexOffset = 0;
+          for(int p = 0; p < csfgeom->numParts; p++)
+          {
+            uint32_t numIndex = csfgeom->parts[p].numIndexSolid;
+            meshletBuilder.buildMeshletsSpatial<uint32_t>(meshletGeometriesSpatial[g], numIndex, csfgeom->indexSolid + indexOffset,
+                                                          (const float*)csfgeom->vertex, sizeof(float) * 3);
+            indexOffset += numIndex;
+          }
+        }
+
+        timeBuildSpatial = std::min(timeBuildSpatial, getTimeMilliseconds() - timeBegin);
+      }
+
+      double timeBegin = getTimeMilliseconds();
+
+#pragma omp parallel for
+      for(int g = 0; g < csf->numGeometries; g++)
+      {
+        const CSFGeometry* csfgeom     = &csf->geometries[g];
+        uint32_t           indexOffset = 0;
+        for(int p = 0; p < csfgeom->numParts; p++)
+        {
+          uint32_t numIndex = csfgeom->parts[p].numIndexSolid;
+          meshletBuilder.buildMeshlets<uint32_t>(meshletGeometries[g], numIndex, csfgeom->indexSolid + indexOffset);
+          indexOffset += numIndex;
+        }
+      }
+
+      timeBuild = std::min(timeBuild, getTimeMilliseconds() - timeBegin);
+
+      // builder with compile-time limits, if available for this limit, output is identical
+      NVMeshlet::dispatchPackBasicBuilder(limit.first, limit.second, [&](auto& fixedBuilder) {
+        fixedBuilder.setup(limit.first, limit.second, false, cfg.meshEncoding == NVMESHLET_ENCODING_PACKDELTA);
+
+        std::vector<NVMeshlet::PackBasicBuilder::MeshletGeometry> meshletGeometriesFixed(csf->numGeometries);
+
+        double timeBeginFixed = getTimeMilliseconds();
+
+#pragma omp parallel for
+        for(int g = 0; g < csf->numGeometries; g++)
+        {
+          const CSFGeometry* csfgeom     = &csf->geometries[g];
+          uint32_t           indexOffset = 0;
+          for(int p = 0; p < csfgeom->numParts; p++)
+          {
+            uint32_t numIndex = csfgeom->parts[p].numIndexSolid;
+            fixedBuilder.template buildMeshlets<uint32_t>(meshletGeometriesFixed[g], numIndex, csfgeom->indexSolid + indexOffset);
+            indexOffset += numIndex;
+          }
+        }
+
+        timeBuildFixed = std::min(timeBuildFixed, getTimeMilliseconds() - timeBeginFixed);
+
+        for(int g = 0; g < csf->numGeometries; g++)
+        {
+          fixedIdentical = fixedIdentical && meshletGeometries[g].meshletPacks == meshletGeometriesFixed[g].meshletPacks;
+        }
+      });
+
+      // the same meshlets for the scalar early culling
+      std::vector<NVMeshlet::PackBasicBuilder::MeshletGeometry> meshletGeometriesScalar = meshletGeometries;
+
+      double timeMid = getTimeMilliseconds();
+
+#pragma omp parallel for
+      for(int g = 0; g < csf->numGeometries; g++)
+      {
+        meshletBuilder.buildMeshletEarlyCulling(meshletGeometries[g], bboxes[g].min.vec_array, bboxes[g].max.vec_array,
+                                                (const float*)csf->geometries[g].vertex, sizeof(float) * 3);
+      }
+
+      double timeEnd = getTimeMilliseconds();
+
+      timeCulling = std::min(timeCulling, timeEnd - timeMid);
+
+#pragma omp parallel for
+      for(int g = 0; g < csf->numGeometries; g++)
+      {
+        meshletBuilder.buildMeshletEarlyCulling<NVMeshlet::EARLY_CULLING_SCALAR>(
+            meshletGeometriesScalar[g], bboxes[g].min.vec_array, bboxes[g].max.vec_array,
+            (const float*)csf->geometries[g].vertex, sizeof(float) * 3);
+      }
+
+      timeCullingScalar = std::min(timeCullingScalar, getTimeMilliseconds() - timeEnd);
+
+      for(int g = 0; g < csf->numGeometries; g++)
+      {
+        const auto& descs       = meshletGeometries[g].meshletDescriptors;
+        const auto& descsScalar = meshletGeometriesScalar[g].meshletDescriptors;
+        cullingIdentical = cullingIdentical && descs.size() == descsScalar.size()
+                           && memcmp(descs.data(), descsScalar.data(), sizeof(NVMeshlet::MeshletPackBasicDesc) * descs.size()) == 0;
+      }
+
+      numMeshlets = 0;
+      for(const auto& meshletGeometry : meshletGeometries)
+      {
+        numMeshlets += meshletGeometry.meshletDescriptors.size();
+      }
+    }
+
+    LOGI("  %3d vertices, %3d primitives: %9zu meshlets, build %9.2f ms (simd lookup %9.2f ms, spatial %9.2f ms, fixed limits %9.2f ms%s), early culling %9.2f ms (scalar %9.2f ms%s)\n",
+         limit.first, limit.second, numMeshlets, timeBuild, timeBuildSimd, timeBuildSpatial, timeBuildFixed,
+         fixedIdentical ? "" : ", MISMATCH", timeCulling, timeCullingScalar, cullingIdentical ? "" : ", MISMATCH")
+  }
+
+  CSFileMemory_delete(csfmem);
+
+  return true;
+}
+
+bool CadScene::tuneMeshletLimits(const char* filename, const LoadConfig& cfg, uint32_t& meshVertexCount, uint32_t& meshPrimitiveCount)
+{
+  CSFile*         csf;
+  CSFileMemoryPTR csfmem = CSFileMemory_new();
+
+  if(CSFile_loadExt(&csf, filename, csfmem) != CADSCENEFILE_NOERROR)
+  {
+    CSFileMemory_delete(csfmem);
+    return false;
+  }
+
+  // limits selectable in the ui plus the configured one
+  std::vector<std::pair<uint32_t, uint32_t>> limits = {{32, 40}, {32, 64}, {64, 64}, {64, 84}, {64, 126}, {96, 126}, {128, 126}};
+  std::pair<uint32_t, uint32_t>              limitConfig(cfg.meshVertexCount, cfg.meshPrimitiveCount);
+  if(std::find(limits.begin(), limits.end(), limitConfig) == limits.end())
+  {
+    limits.push_back(limitConfig);
+  }
+
+  const size_t numLimits       = limits.size();
+  const size_t limitConfigured = std::find(limits.begin(), limits.end(), limitConfig) - limits.begin();
+
+  // stats per geometry and limit
+  std::vector<NVMeshlet::Stats> geometryStats(size_t(csf->numGeometries) * numLimits);
+
+  for(size_t l = 0; l < numLimits; l++)
+  {
+    NVMeshlet::PackBasicBuilder meshletBuilder{};
+    meshletBuilder.setup(limits[l].first, limits[l].second, false, cfg.meshEncoding == NVMESHLET_ENCODING_PACKDELTA);
+
+#pragma omp parallel for schedule(dynamic)
+    for(int g = 0; g < csf->numGeometries; g++)
+    {
+      const CSFGeometry* csfgeom = &csf->geometries[g];
+
+      NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometry;
+
+      uint32_t indexOffset = 0;
+      for(int p = 0; p < csfgeom->numParts; p++)
+      {
+        uint32_t numIndex = csfgeom->parts[p].numIndexSolid;
+        if(cfg.meshBuilder == MESHLET_BUILDER_SPATIAL)
+        {
+          meshletBuilder.buildMeshletsSpatial<uint32_t>(meshletGeometry, numIndex, csfgeom->indexSolid + indexOffset,
+                                                        (const float*)csfgeom->vertex, sizeof(float) * 3);
+        }
+        else
+        {
+          meshletBuilder.buildMeshlets<uint32_t>(meshletGeometry, numIndex, csfgeom->indexSolid + indexOffset);
+        }
+        indexOffset += numIndex;
+      }
+      if(cfg.meshletStrips)
+      {
+        meshletBuilder.buildMeshletStrips(meshletGeometry);
+      }
+
+      meshletBuilder.appendStats(meshletGeometry, geometryStats[size_t(g) * numLimits + l]);
+    }
+  }
+
+  struct Candidate
+  {
+    size_t           limit;
+    NVMeshlet::Stats stats;
+    // weighted by the triangles of each geometry
+    double score = 0;
+    double fill  = 0;
+    // geometries and their triangles for which this limit scores best
+    uint32_t geometriesWon = 0;
+    size_t   trianglesWon  = 0;
+  };
+
+  std::vector<Candidate> candidates(numLimits);
+  size_t                 trianglesTotal = 0;
+  for(size_t l = 0; l < numLimits; l++)
+  {
+    candidates[l].limit = l;
+  }
+
+  for(int g = 0; g < csf->numGeometries; g++)
+  {
+    const NVMeshlet::Stats* stats = &geometryStats[size_t(g) * numLimits];
+
+    size_t best = 0;
+    for(size_t l = 0; l < numLimits; l++)
+    {
+      candidates[l].stats.append(stats[l]);
+      candidates[l].score += stats[l].getScore() * double(stats[l].primTotal);
+      candidates[l].fill += stats[l].getFill() * double(stats[l].primTotal);
+      if(stats[l].getScore() > stats[best].getScore())
+      {
+        best = l;
+      }
+    }
+
+    if(stats[best].meshletsTotal)
+    {
+      candidates[best].geometriesWon++;
+      candidates[best].trianglesWon += stats[best].primTotal;
+      trianglesTotal += stats[best].primTotal;
+    }
+
+    if(cfg.verbose && stats[best].meshletsTotal)
+    {
+      LOGI("meshlet tuning: geometry %5d: %6zu triangles, best %3d vertices, %3d primitives (score %.3f)\n", g,
+           stats[best].primTotal, limits[best].first, limits[best].second, stats[best].getScore())
+    }
+  }
+
+  // shaders need uniform limits, rank them for the whole scene
+  for(Candidate& candidate : candidates)
+  {
+    candidate.score /= trianglesTotal ? double(trianglesTotal) : 1.0;
+    candidate.fill /= trianglesTotal ? double(trianglesTotal) : 1.0;
+  }
+  std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) { return a.score > b.score; });
+
+  LOGI("meshlet tuning: %s (%d geometries, %s builder)\n", filename, csf->numGeometries,
+       cfg.meshBuilder == MESHLET_BUILDER_SPATIAL ? "spatial" : "index order")
+  LOGI("  rank; vertices; primitives; score; fill; tris per vertex; waste; meshlets; geometries won; triangles won;\n")
+  for(size_t c = 0; c < candidates.size(); c++)
+  {
+    const Candidate&        candidate = candidates[c];
+    const NVMeshlet::Stats& stats     = candidate.stats;
+
+    LOGI("  %4zu; %8d; %10d; %5.3f; %4.2f; %15.2f; %5.2f; %8zu; %14d; %12.1f%%;%s\n", c + 1, limits[candidate.limit].first,
+         limits[candidate.limit].second, candidate.score, candidate.fill,
+         stats.vertexTotal ? double(stats.primTotal) / double(stats.vertexTotal) : 0.0, stats.getWaste(), stats.meshletsTotal,
+         candidate.geometriesWon, trianglesTotal ? double(candidate.trianglesWon) * 100.0 / double(trianglesTotal) : 0.0,
+         candidate.limit == limitConfigured ? " (configured)" : "")
+  }
+
+  meshVertexCount    = limits[candidates[0].limit].first;
+  meshPrimitiveCount = limits[candidates[0].limit].second;
+
+  CSFileMemory_delete(csfmem);
+
+  return true;
+}
+
+// decodes the cone like decodeNormalAngle in nvmeshlet_utils.glsl
+static void decodeMeshletCone(const NVMeshlet::MeshletPackBasicDesc& meshlet, float normal[3], float& angle)
+{
+  int8_t coneX;
+  int8_t coneY;
+  int8_t coneAngle;
+  meshlet.getCone(coneX, coneY, coneAngle);
+
+  float x = std::max(float(coneX) / 127.0f, -1.0f);
+  float y = std::max(float(coneY) / 127.0f, -1.0f);
+  float z = 1.0f - fabsf(x) - fabsf(y);
+  if(z < 0)
+  {
+    float ox = x;
+    x        = (1.0f - fabsf(y)) * (ox >= 0 ? 1.0f : -1.0f);
+    y        = (1.0f - fabsf(ox)) * (y >= 0 ? 1.0f : -1.0f);
+  }
+  float length = sqrtf(x * x + y * y + z * z);
+  normal[0]    = x / length;
+  normal[1]    = y / length;
+  normal[2]    = z / length;
+  angle        = std::max(float(coneAngle) / 127.0f, -1.0f);
+}
+
+bool CadScene::fuzzMeshletBuilder(uint32_t iterations, uint32_t seed)
+{
+  const uint32_t vertexLimits[]    = {32, 64, 96, 128, 256};
+  const uint32_t primitiveLimits[] = {32, 40, 64, 84, 96, 126, 128, 256};
+
+  uint32_t failures = 0;
+  uint64_t checks   = 0;
+
+  LOGI("meshlet fuzz: %d iterations, seed %d\n", iterations, seed)
+
+  for(uint32_t it = 0; it < iterations; it++)
+  {
+    // every iteration is reproducible on its own
+    std::mt19937                          rng(seed + it);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    auto                                  random = [&](uint32_t num) { return uint32_t(rng() % num); };
+
+    // offset all vertices, above 65535 forces 32 bit vertex indices
+    uint32_t vertexBase = random(4) == 0 ? 65536 + random(1 << 20) : random(64);
+    bool     large      = random(16) == 0;
+
+    std::vector<float>    positions(size_t(vertexBase) * 3, 0.0f);
+    std::vector<uint32_t> indices;
+
+    // grid surface, shared vertices as in typical meshes
+    {
+      uint32_t width   = large ? 400 + random(200) : 1 + random(64);
+      uint32_t height  = large ? 400 + random(200) : 1 + random(64);
+      float    bumpy   = unit(rng) * 4.0f;
+      uint32_t gridBase = uint32_t(positions.size() / 3);
+      for(uint32_t y = 0; y <= height; y++)
+      {
+        for(uint32_t x = 0; x <= width; x++)
+        {
+          positions.push_back(float(x));
+          positions.push_back(float(y));
+          positions.push_back(bumpy * sinf(float(x) * 0.7f) * cosf(float(y) * 0.3f));
+        }
+      }
+      for(uint32_t y = 0; y < height; y++)
+      {
+        for(uint32_t x = 0; x < width; x++)
+        {
+          uint32_t a = gridBase + y * (width + 1) + x;
+          uint32_t b = a + 1;
+          uint32_t c = a + width + 1;
+          uint32_t d = c + 1;
+          indices.insert(indices.end(), {a, b, c, b, d, c});
+        }
+      }
+    }
+
+    // triangle soup spread across the vertices, including collinear triangles
+    {
+      uint32_t soupBase  = uint32_t(positions.size() / 3);
+      uint32_t soupVerts = 3 + random(large ? 200000 : 2000);
+      for(uint32_t v = 0; v < soupVerts; v++)
+      {
+        bool collinear = random(8) == 0 && v >= 2;
+        for(uint32_t k = 0; k < 3; k++)
+        {
+          positions.push_back(collinear ? positions[(soupBase + v - 1) * 3 + k] * 2.0f - positions[(soupBase + v - 2) * 3 + k] :
+                                          unit(rng) * 100.0f - 50.0f);
+        }
+      }
+      uint32_t soupTris = random(large ? 100000 : 3000);
+      for(uint32_t t = 0; t < soupTris; t++)
+      {
+        uint32_t a = soupBase + random(soupVerts);
+        uint32_t b = random(4) == 0 ? a + 1 : soupBase + random(soupVerts);
+        uint32_t c = random(4) == 0 ? b + 1 : soupBase + random(soupVerts);
+        indices.insert(indices.end(), {a, std::min(b, soupBase + soupVerts - 1), std::min(c, soupBase + soupVerts - 1)});
+      }
+    }
+
+    // degenerate triangles with repeated indices anywhere
+    uint32_t numTris = uint32_t(indices.size() / 3);
+    for(uint32_t d = random(numTris / 8 + 1); d > 0; d--)
+    {
+      uint32_t t = random(numTris);
+      indices[t * 3 + 1 + random(2)] = indices[t * 3];
+    }
+
+    // parts split the indices at random triangles
+    std::vector<uint32_t> partIndices;
+    {
+      uint32_t numParts = 1 + random(4);
+      uint32_t begin    = 0;
+      for(uint32_t p = 0; p < numParts; p++)
+      {
+        uint32_t end = p + 1 == numParts ? numTris : begin + random(numTris - begin + 1);
+        partIndices.push_back((end - begin) * 3);
+        begin = end;
+      }
+    }
+
+    uint32_t numVertices = uint32_t(positions.size() / 3);
+    bool     deltaVertices = random(2) == 0;
+
+    float objectMin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+    float objectMax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for(uint32_t v = vertexBase; v < numVertices; v++)
+    {
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        objectMin[k] = std::min(objectMin[k], positions[v * 3 + k]);
+        objectMax[k] = std::max(objectMax[k], positions[v * 3 + k]);
+      }
+    }
+
+    for(uint32_t vertexLimit : vertexLimits)
+    {
+      for(uint32_t primitiveLimit : primitiveLimits)
+      {
+        auto fail = [&](const char* what) {
+          LOGE("meshlet fuzz: iteration %d (seed %d), %d vertices, %d primitives, %d triangles: %s\n", it, seed + it,
+               vertexLimit, primitiveLimit, numTris, what)
+          failures++;
+        };
+
+        NVMeshlet::PackBasicBuilder meshletBuilder{};
+        meshletBuilder.setup(vertexLimit, primitiveLimit, false, deltaVertices);
+
+        NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometry;
+        NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometrySimd;
+        NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometrySpatial;
+
+        uint32_t indexOffset = 0;
+        for(uint32_t numIndex : partIndices)
+        {
+          if(meshletBuilder.buildMeshlets<uint32_t>(meshletGeometry, numIndex, indices.data() + indexOffset) != numIndex)
+          {
+            fail("incomplete build");
+          }
+          meshletBuilder.buildMeshlets<uint32_t, NVMeshlet::PRIMITIVE_CACHE_LOOKUP_SIMD>(meshletGeometrySimd, numIndex,
+                                                                                        indices.data() + indexOffset);
+          meshletBuilder.buildMeshletsSpatial<uint32_t>(meshletGeometrySpatial, numIndex, indices.data() + indexOffset,
+                                                        positions.data(), sizeof(float) * 3);
+          indexOffset += numIndex;
+        }
+
+        if(meshletBuilder.errorCheck<uint32_t>(meshletGeometry, vertexBase, numVertices - 1, numTris * 3, indices.data()))
+        {
+          fail("errorCheck");
+        }
+        if(meshletBuilder.errorCheckUnordered<uint32_t>(meshletGeometrySpatial, vertexBase, numVertices - 1, numTris * 3,
+                                                        indices.data()))
+        {
+          fail("errorCheckUnordered (spatial)");
+        }
+        if(meshletGeometrySimd.meshletPacks != meshletGeometry.meshletPacks)
+        {
+          fail("simd lookup differs");
+        }
+
+        NVMeshlet::dispatchPackBasicBuilder(vertexLimit, primitiveLimit, [&](auto& fixedBuilder) {
+          fixedBuilder.setup(vertexLimit, primitiveLimit, false, deltaVertices);
+
+          NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometryFixed;
+
+          uint32_t indexOffsetFixed = 0;
+          for(uint32_t numIndex : partIndices)
+          {
+            fixedBuilder.template buildMeshlets<uint32_t>(meshletGeometryFixed, numIndex, indices.data() + indexOffsetFixed);
+            indexOffsetFixed += numIndex;
+          }
+          if(meshletGeometryFixed.meshletPacks != meshletGeometry.meshletPacks)
+          {
+            fail("fixed limits differ");
+          }
+        });
+
+        NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometryScalar = meshletGeometry;
+        meshletBuilder.buildMeshletEarlyCulling(meshletGeometry, objectMin, objectMax, positions.data(), sizeof(float) * 3);
+        meshletBuilder.buildMeshletEarlyCulling<NVMeshlet::EARLY_CULLING_SCALAR>(meshletGeometryScalar, objectMin, objectMax,
+                                                                                 positions.data(), sizeof(float) * 3);
+
+        const auto& descs       = meshletGeometry.meshletDescriptors;
+        const auto& descsScalar = meshletGeometryScalar.meshletDescriptors;
+        if(descs.size() != descsScalar.size()
+           || memcmp(descs.data(), descsScalar.data(), sizeof(NVMeshlet::MeshletPackBasicDesc) * descs.size()) != 0)
+        {
+          fail("simd early culling differs");
+        }
+
+        // strips only change the order and first vertex of the triangles within meshlets
+        NVMeshlet::PackBasicBuilder::MeshletGeometry meshletGeometryStrips = meshletGeometry;
+        meshletBuilder.buildMeshletStrips(meshletGeometryStrips);
+        if(meshletBuilder.errorCheckUnordered<uint32_t>(meshletGeometryStrips, vertexBase, numVertices - 1, numTris * 3,
+                                                        indices.data()))
+        {
+          fail("errorCheckUnordered (strips)");
+        }
+
+        // The cone must never cull a visible triangle. Like earlyCull in the task shader,
+        // a meshlet is backface culled when all corners of its quantized bbox see the
+        // cone from behind. Eyes are placed randomly around the object.
+        float objectExtent[3];
+        for(uint32_t k = 0; k < 3; k++)
+        {
+          objectExtent[k] = objectMax[k] - objectMin[k];
+        }
+        float eyeRange = std::max(std::max(objectExtent[0], objectExtent[1]), std::max(objectExtent[2], 1.0f)) * 3.0f;
+
+        bool coneFailed = false;
+        for(const NVMeshlet::MeshletPackBasicDesc& meshlet : descs)
+        {
+          float coneNormal[3];
+          float coneAngle;
+          decodeMeshletCone(meshlet, coneNormal, coneAngle);
+          if(meshlet.getNumVertices() == 1 || !(coneAngle < 0) || coneFailed)
+          {
+            continue;
+          }
+
+          uint8_t gridMin[3];
+          uint8_t gridMax[3];
+          meshlet.getBBox(gridMin, gridMax);
+
+          const auto* pack       = (const NVMeshlet::MeshletPackBasic*)&meshletGeometry.meshletPacks[meshlet.getPackOffset()];
+          uint32_t    vertexPack = meshlet.getNumVertexPack();
+
+          for(uint32_t e = 0; e < 16 && !coneFailed; e++)
+          {
+            float eye[3];
+            for(uint32_t k = 0; k < 3; k++)
+            {
+              eye[k] = objectMin[k] + objectExtent[k] * 0.5f + (unit(rng) - 0.5f) * eyeRange;
+            }
+
+            bool backface = true;
+            for(uint32_t n = 0; n < 8 && backface; n++)
+            {
+              float dir[3];
+              float dirLength = 0;
+              for(uint32_t k = 0; k < 3; k++)
+              {
+                float corner = objectMin[k] + float((n >> k) & 1 ? gridMax[k] : gridMin[k]) / 255.0f * objectExtent[k];
+                dir[k]       = eye[k] - corner;
+                dirLength += dir[k] * dir[k];
+              }
+              dirLength = sqrtf(dirLength);
+              backface  = (coneNormal[0] * dir[0] + coneNormal[1] * dir[1] + coneNormal[2] * dir[2]) < coneAngle * dirLength;
+            }
+            if(!backface)
+            {
+              continue;
+            }
+
+            for(uint32_t p = 0; p < meshlet.getNumPrims(); p++)
+            {
+              uint8_t prim[3];
+              pack->getPrimIndices(meshlet, p, prim);
+              const float* a = &positions[pack->getVertexIndex(prim[0], vertexPack) * 3];
+              const float* b = &positions[pack->getVertexIndex(prim[1], vertexPack) * 3];
+              const float* c = &positions[pack->getVertexIndex(prim[2], vertexPack) * 3];
+
+              float ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+              float ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+              float ae[3] = {eye[0] - a[0], eye[1] - a[1], eye[2] - a[2]};
+              float normal[3] = {ab[1] * ac[2] - ab[2] * ac[1], ab[2] * ac[0] - ab[0] * ac[2], ab[0] * ac[1] - ab[1] * ac[0]};
+
+              float facing = normal[0] * ae[0] + normal[1] * ae[1] + normal[2] * ae[2];
+              float scale  = sqrtf((normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2])
+                                   * (ae[0] * ae[0] + ae[1] * ae[1] + ae[2] * ae[2]));
+              if(facing > scale * 1.0e-4f)
+              {
+                fail("cone culls a visible triangle");
+                coneFailed = true;
+                break;
+              }
+            }
+          }
+        }
+
+        checks++;
+      }
+    }
+  }
+
+  LOGI("meshlet fuzz: %zu builds checked, %d failures\n", size_t(checks), failures)
+
+  return failures == 0;
 }
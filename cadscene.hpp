@@ -22,13 +22,20 @@
 #define CADSCENE_H__
 
 #include <nvmath/nvmath.h>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "config.h"
+#include "nvmeshlet_packbasic.hpp"
 
 typedef unsigned short half;
 
+namespace nvh {
+class FileReadMapping;
+}
+
 class CadScene
 {
 
@@ -127,6 +134,13 @@ public:
     nvmath::vec4f color;
   };
 
+  // need to keep this 256 byte aligned (UBO range)
+  struct CopyNode
+  {
+    nvmath::vec4f offset;
+    nvmath::vec4f _pad[15];
+  };
+
   struct Vertex
   {
     nvmath::vec4f position;
@@ -187,6 +201,8 @@ public:
   {
     DrawRange    indexSolid;
     MeshletRange meshSolid{};
+    // all levels of the lod hierarchy, see nvmeshlet_lod.hpp
+    MeshletRange meshLod{};
   };
 
   struct MeshletTopology
@@ -196,23 +212,17 @@ public:
 
     int numMeshlets = 0;
 
-    // may not be used
-    void* primData = nullptr;
-    void* descData = nullptr;
+    // may not be used, moved from the builder's output
+    std::vector<NVMeshlet::PackBasicType>        primData;
+    std::vector<NVMeshlet::MeshletPackBasicDesc> descData;
 
-    ~MeshletTopology()
-    {
-      if(primData)
-      {
-        free(primData);
-      }
-      if(descData)
-      {
-        free(descData);
-      }
-    }
-  };
+    // baked scenes reference the file mapping instead of the vectors
+    const NVMeshlet::PackBasicType*        primMapped = nullptr;
+    const NVMeshlet::MeshletPackBasicDesc* descMapped = nullptr;
 
+    const NVMeshlet::PackBasicType* getPrimData() const { return primMapped ? primMapped : primData.data(); }
+    const NVMeshlet::MeshletPackBasicDesc* getDescData() const { return descMapped ? descMapped : descData.data(); }
+  };
 
   struct Geometry
   {
@@ -237,8 +247,15 @@ public:
     void* aboData = nullptr;
     void* iboData = nullptr;
 
+    // the data points into CadScene::m_bakedMapping
+    bool mappedData = false;
+
     ~Geometry()
     {
+      if(mappedData)
+      {
+        return;
+      }
       if(vboData)
       {
         free(vboData);
@@ -285,6 +302,50 @@ public:
     uint32_t meshPrimitiveCount = 126;
 
     MeshletBuilderType meshBuilder = MESHLET_BUILDER_PACKBASIC;
+    // NVMESHLET_ENCODING_PACKBASIC or NVMESHLET_ENCODING_PACKDELTA
+    uint32_t meshEncoding = NVMESHLET_ENCODING_PACKBASIC;
+    // store positions quantized to this many bits within the meshlets, 0 disables
+    uint32_t meshPositionBits = 0;
+
+    // reorder triangles and vertices for locality prior to meshlet building
+    bool optimizeVertexOrder = false;
+    // store meshlet topology in "<file>.meshletcache" and reuse it for unchanged geometries
+    bool meshletCache = false;
+    // pad each part's meshlets to a multiple of this (NVMESHLET_PER_TASK), 0 disables
+    uint32_t meshTaskPadding = 0;
+    // meshlets span consecutive parts, their primitives store the part (index order builder only)
+    bool meshletMergeParts = false;
+    // collapse vertices with equal position, normal and texcoord prior to meshlet building
+    bool weldVertices = false;
+    // grid cell size for weld comparisons, 0 requires bitwise equality
+    float weldEpsilon = 0.0f;
+    // build a meshlet lod hierarchy per part, drawn via task shaders (not with meshletMergeParts)
+    bool meshletLod = false;
+    // verify the built meshlets against the indices, failures are counted in m_meshletErrors
+    bool meshletErrorCheck = false;
+    // store the primitives of each meshlet as triangle strips (not with meshletMergeParts)
+    bool meshletStrips = false;
+    // map uncompressed .csf files instead of reading them into memory, each geometry's
+    // pages are released once converted (falls back to regular loading otherwise)
+    bool mapFile = false;
+  };
+
+  // counters of a load in progress, can be polled from other threads
+  struct LoadProgress
+  {
+    std::atomic<uint32_t> geometries{0};
+    std::atomic<uint32_t> numGeometries{0};
+    // meshlet build tasks and per geometry passes
+    std::atomic<uint32_t> meshletSteps{0};
+    std::atomic<uint32_t> numMeshletSteps{0};
+
+    void reset()
+    {
+      geometries      = 0;
+      numGeometries   = 0;
+      meshletSteps    = 0;
+      numMeshletSteps = 0;
+    }
   };
 
   std::vector<Material>   m_materials;
@@ -298,18 +359,53 @@ public:
   size_t   m_meshSize         = 0;
   uint32_t m_numGeometryParts = 0;
   uint32_t m_numObjectParts   = 0;
+  // geometries that failed LoadConfig::meshletErrorCheck
+  uint32_t m_meshletErrors = 0;
 
   LoadConfig m_cfg;
   BBox       m_bbox;
   BBox       m_bboxInstanced;
 
-  size_t m_numOrigGeometries;
-  size_t m_numOrigMatrices;
-  size_t m_numOrigObjects;
+  // Scene copies share m_objects and m_matrices. Copy c translates the world matrices
+  // by m_copyOffsets[c] (the first copy is the original scene), the renderers bind the
+  // copy's CopyNode per draw and the shaders add it to the world-space positions.
+  std::vector<nvmath::vec4f> m_copyOffsets;
+  int                        m_rootIDX = 0;
+
+  // optional, updated by loadCSF and loadBaked
+  LoadProgress* m_progress = nullptr;
 
   bool loadCSF(const char* filename, const LoadConfig& cfg, int clones = 0, int cloneaxis = 3);
   void unload();
 
+  // .csfbake files store everything loadCSF derives, laid out for uploads straight
+  // from the file mapping. The meshlet and vertex settings of the file replace
+  // the ones in cfg, clones are applied at load time.
+  bool loadBaked(const char* filename, const LoadConfig& cfg, int clones = 0, int cloneaxis = 3);
+  bool saveBaked(const char* filename) const;
+
+  // writes stats and histograms of the loaded meshlets as JSON, in total
+  // and per geometry, lod hierarchies are not included
+  bool saveMeshletStats(const char* filename) const;
+
+  // loads the file and times the meshlet builder with a few
+  // common vertex/primitive limits, results are printed to the log
+  static bool benchmarkMeshletBuilder(const char* filename, const LoadConfig& cfg);
+
+  // times the fp16 vertex conversion per vertex and batched against a memcpy,
+  // results are printed to the log, returns false if both paths differ
+  static bool benchmarkHalfConversion(uint32_t numVertices);
+
+  // loads the file and builds every geometry with a few candidate
+  // vertex/primitive limits, prints a ranked report and returns the
+  // limits with the best triangle weighted score, see NVMeshlet::Stats::getScore
+  static bool tuneMeshletLimits(const char* filename, const LoadConfig& cfg, uint32_t& meshVertexCount, uint32_t& meshPrimitiveCount);
+
+  // builds random meshes (degenerate triangles, 32 bit vertex indices, large parts)
+  // with all vertex/primitive limits and checks the builder variants against each other,
+  // PackBasicBuilder::errorCheck and the cone culling, returns false on any failure
+  static bool fuzzMeshletBuilder(uint32_t iterations, uint32_t seed);
+
 
   [[nodiscard]] size_t getVertexSize() const { return m_cfg.fp16 ? sizeof(VertexFP16) : sizeof(Vertex); }
 
@@ -326,8 +422,32 @@ public:
     return ((uint8_t*)data) + (getVertexAttributeSize() * index);
   }
 
+  [[nodiscard]] size_t getNumCopies() const { return m_copyOffsets.size(); }
+  [[nodiscard]] size_t getNumInstancedObjects() const { return m_objects.size() * m_copyOffsets.size(); }
+
+  // fills getNumCopies() nodes from m_copyOffsets
+  void getCopyNodes(CopyNode* nodes) const;
+
 private:
-  void buildMeshletTopology(const struct _CSFile* csf);
+  // fills m_copyOffsets and m_bboxInstanced
+  void setupCopies(int clones, int cloneaxis, int rootIDX);
+
+  // cacheFilename may be nullptr
+  void buildMeshletTopology(const struct _CSFile* csf, const char* cacheFilename);
+
+  // returns the number of geometries whose topology was loaded, marked in "cached"
+  uint32_t loadMeshletCache(const char* filename, const std::vector<uint64_t>& hashes, std::vector<uint8_t>& cached);
+  bool     saveMeshletCache(const char* filename, const std::vector<uint64_t>& hashes) const;
+
+  // LoadConfig::mapFile, frees the geometry's private copy or drops its mapped pages,
+  // the source must not be accessed afterwards
+  void releaseGeometrySource(const struct _CSFGeometry* csfgeom, int geometry);
+
+  // per geometry while a mapped file is loaded, empty unless modified in place
+  std::vector<std::vector<uint8_t>> m_sourceCopies;
+
+  // kept open while the geometries reference it, see loadBaked
+  std::shared_ptr<nvh::FileReadMapping> m_bakedMapping;
 };
 
 
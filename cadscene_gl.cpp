@@ -259,15 +259,21 @@ void CadSceneGL::init(const CadScene& cadscene)
     GLintptr descOffset = static_cast<GLintptr>(geom.mem.meshOffset);
     GLintptr primOffset = static_cast<GLintptr>(geom.mem.meshIndicesOffset);
 
-    glNamedBufferSubData(chunk.meshGL, descOffset, static_cast<GLsizeiptr>(cadgeom.meshlet.descSize), cadgeom.meshlet.descData);
-    glNamedBufferSubData(chunk.meshIndicesGL, primOffset, static_cast<GLsizeiptr>(cadgeom.meshlet.primSize), cadgeom.meshlet.primData);
+    glNamedBufferSubData(chunk.meshGL, descOffset, static_cast<GLsizeiptr>(cadgeom.meshlet.descSize), cadgeom.meshlet.getDescData());
+    glNamedBufferSubData(chunk.meshIndicesGL, primOffset, static_cast<GLsizeiptr>(cadgeom.meshlet.primSize), cadgeom.meshlet.getPrimData());
 
     geom.topoMeshlet = nvgl::BufferBinding(chunk.meshGL, descOffset, static_cast<GLsizeiptr>(cadgeom.meshlet.descSize), chunk.meshADDR);
     geom.topoPrim    = nvgl::BufferBinding(chunk.meshIndicesGL, primOffset, static_cast<GLsizeiptr>(cadgeom.meshlet.primSize), chunk.meshIndicesADDR);
   }
 
   m_buffers.materials.create(sizeof(CadScene::Material) * cadscene.m_materials.size(), cadscene.m_materials.data(), 0, 0);
+
   m_buffers.matrices.create(sizeof(CadScene::MatrixNode) * cadscene.m_matrices.size(), cadscene.m_matrices.data(), 0, 0);
+
+  // copies share the matrices, the shaders add the copy's offset
+  std::vector<CadScene::CopyNode> copyNodes(cadscene.getNumCopies());
+  cadscene.getCopyNodes(copyNodes.data());
+  m_buffers.copies.create(sizeof(CadScene::CopyNode) * copyNodes.size(), copyNodes.data(), 0, 0);
 }
 
 void CadSceneGL::deinit()
@@ -275,6 +281,7 @@ void CadSceneGL::deinit()
   if(m_geometry.empty())
     return;
 
+  m_buffers.copies.destroy();
   m_buffers.matrices.destroy();
   m_buffers.materials.destroy();
 
@@ -163,6 +163,7 @@ public:
   struct Buffers
   {
     nvgl::Buffer matrices;
+    nvgl::Buffer copies;
     nvgl::Buffer materials;
   };
 
@@ -242,12 +242,12 @@ void CadSceneVK::init(const CadScene& cadscene, VkDevice device, VkPhysicalDevic
       geom.meshletDesc.buffer = chunk.mesh;
       geom.meshletDesc.offset = geom.allocation.meshOffset;
       geom.meshletDesc.range  = cadgeom.meshlet.descSize;
-      staging.upload(geom.meshletDesc, cadgeom.meshlet.descData);
+      staging.upload(geom.meshletDesc, cadgeom.meshlet.getDescData());
 
       geom.meshletPrim.buffer = chunk.meshIndices;
       geom.meshletPrim.offset = geom.allocation.meshIndicesOffset;
       geom.meshletPrim.range  = cadgeom.meshlet.primSize;
-      staging.upload(geom.meshletPrim, cadgeom.meshlet.primData);
+      staging.upload(geom.meshletPrim, cadgeom.meshlet.getPrimData());
     }
   }
 
@@ -257,15 +257,24 @@ void CadSceneVK::init(const CadScene& cadscene, VkDevice device, VkPhysicalDevic
                                                     bufferUsage, m_buffers.materialsAID);
   m_buffers.matrices  = m_memAllocator.createBuffer(cadscene.m_matrices.size() * sizeof(CadScene::MatrixNode),
                                                    bufferUsage, m_buffers.matricesAID);
+  m_buffers.copies    = m_memAllocator.createBuffer(cadscene.getNumCopies() * sizeof(CadScene::CopyNode),
+                                                   bufferUsage, m_buffers.copiesAID);
 
   m_infos.materialsSingle = {m_buffers.materials, 0, sizeof(CadScene::Material)};
   m_infos.materials       = {m_buffers.materials, 0, cadscene.m_materials.size() * sizeof(CadScene::Material)};
   m_infos.matricesSingle  = {m_buffers.matrices, 0, sizeof(CadScene::MatrixNode)};
   m_infos.matrices        = {m_buffers.matrices, 0, cadscene.m_matrices.size() * sizeof(CadScene::MatrixNode)};
+  m_infos.copiesSingle    = {m_buffers.copies, 0, sizeof(CadScene::CopyNode)};
+  m_infos.copies          = {m_buffers.copies, 0, cadscene.getNumCopies() * sizeof(CadScene::CopyNode)};
 
   staging.upload(m_infos.materials, cadscene.m_materials.data());
   staging.upload(m_infos.matrices, cadscene.m_matrices.data());
 
+  // copies share the matrices, the shaders add the copy's offset
+  std::vector<CadScene::CopyNode> copyNodes(cadscene.getNumCopies());
+  cadscene.getCopyNodes(copyNodes.data());
+  staging.upload(m_infos.copies, copyNodes.data());
+
   staging.upload({}, nullptr);
 }
 
@@ -273,7 +282,9 @@ void CadSceneVK::deinit()
 {
   vkDestroyBuffer(m_device, m_buffers.materials, nullptr);
   vkDestroyBuffer(m_device, m_buffers.matrices, nullptr);
+  vkDestroyBuffer(m_device, m_buffers.copies, nullptr);
 
+  m_memAllocator.free(m_buffers.copiesAID);
   m_memAllocator.free(m_buffers.matricesAID);
   m_memAllocator.free(m_buffers.materialsAID);
   m_geometry.clear();
@@ -221,9 +221,11 @@ public:
   {
     VkBuffer materials = VK_NULL_HANDLE;
     VkBuffer matrices  = VK_NULL_HANDLE;
+    VkBuffer copies    = VK_NULL_HANDLE;
 
     nvvk::AllocationID materialsAID;
     nvvk::AllocationID matricesAID;
+    nvvk::AllocationID copiesAID;
   };
 
   struct Infos
@@ -232,6 +234,8 @@ public:
     VkDescriptorBufferInfo materials;
     VkDescriptorBufferInfo matricesSingle;
     VkDescriptorBufferInfo matrices;
+    VkDescriptorBufferInfo copiesSingle;
+    VkDescriptorBufferInfo copies;
   };
 
 
@@ -55,6 +55,28 @@
 #define NVMESHLET_ENCODING NVMESHLET_ENCODING_PACKBASIC
 #endif
 
+// bits of the quantized positions within meshlet packs,
+// 0 fetches positions from the vertex buffer
+#ifndef NVMESHLET_POSITION_BITS
+#define NVMESHLET_POSITION_BITS 0
+#endif
+
+// meshlets contain the primitives of several parts,
+// primitives of parts outside the draw's part range are discarded
+#ifndef NVMESHLET_MERGED_PARTS
+#define NVMESHLET_MERGED_PARTS 0
+#endif
+
+// draws select the cut of the meshlet lod hierarchy in the task stage
+#ifndef NVMESHLET_LOD
+#define NVMESHLET_LOD 0
+#endif
+
+// meshlet primitives are stored as triangle strips
+#ifndef NVMESHLET_PRIMITIVE_STRIPS
+#define NVMESHLET_PRIMITIVE_STRIPS 0
+#endif
+
 /////////////////////////////////////////////////
 // EXT_mesh_shader preferences
 //
@@ -202,6 +224,7 @@
 #define UBO_SCENE_VIEW 0
 #define UBO_OBJECT 1
 #define UBO_GEOMETRY 2
+#define UBO_COPY 3
 #define SSBO_SCENE_STATS 0
 
 // VK
@@ -242,9 +265,9 @@ struct SceneData
   ivec2 viewport;
   vec2  viewportf;
 
-  vec2 viewportTaskCull;
-  int  colorize;
-  int  _pad0;
+  vec2  viewportTaskCull;
+  int   colorize;
+  float lodErrorScale;
 
   vec4 wClipPlanes[NUM_CLIPPING_PLANES];
 };
@@ -36,6 +36,8 @@
 #define NVMESHLET_INDICES_PER_FETCH 8
 
 #define NVMESHLET_ENCODING_PACKBASIC 1
+// same as PACKBASIC but vertex indices are stored as base + bit-packed deltas
+#define NVMESHLET_ENCODING_PACKDELTA 2
 
 #if !defined(__cplusplus)
 #ifdef VULKAN
@@ -59,6 +61,9 @@
 
   enum MeshletBuilderType {
     MESHLET_BUILDER_PACKBASIC,
+    // same encoding as PACKBASIC, but meshlets are grown over
+    // the triangle adjacency rather than in index order
+    MESHLET_BUILDER_SPATIAL,
   };
 
 #endif
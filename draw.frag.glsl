@@ -44,6 +44,10 @@
   layout(std140,binding=0,set=DSET_OBJECT) uniform objectBuffer {
     ObjectData object;
   };
+
+  layout(std140,binding=1,set=DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
   
 #else
 
@@ -55,6 +59,10 @@
     ObjectData object;
   };
 
+  layout(std140,binding=UBO_COPY) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
 #endif
 
 //////////////////////////////////////////////////
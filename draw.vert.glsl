@@ -44,6 +44,10 @@
   layout(std140,binding=0,set=DSET_OBJECT) uniform objectBuffer {
     ObjectData object;
   };
+
+  layout(std140,binding=1,set=DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
   
 #else
 
@@ -55,6 +59,10 @@
     ObjectData object;
   };
 
+  layout(std140,binding=UBO_COPY) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
 #endif
 
 //////////////////////////////////////////////////
@@ -103,7 +111,7 @@ out float gl_ClipDistance[NUM_CLIPPING_PLANES];
 
 void main()
 {
-  vec3 wPos     = (object.worldMatrix  * vec4(oPos,1)).xyz;
+  vec3 wPos     = (object.worldMatrix  * vec4(oPos,1)).xyz + copyOffset.xyz;
   gl_Position   = (scene.viewProjMatrix * vec4(wPos,1));
 
   
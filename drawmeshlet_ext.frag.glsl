@@ -41,6 +41,10 @@
   layout(std140,binding=0,set=DSET_OBJECT) uniform objectBuffer {
     ObjectData object;
   };
+
+  layout(std140,binding=1,set=DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
   
   #if USE_BARYCENTRIC_SHADING
   layout(std430, binding = GEOMETRY_SSBO_MESHLETDESC, set = DSET_GEOMETRY) buffer meshletDescBuffer {
@@ -132,7 +136,7 @@ void main()
 #elif USE_BARYCENTRIC_SHADING
 
   vec3 oPos = getPosition(INBary[0].vidx) * gl_BaryCoordNV.x + getPosition(INBary[1].vidx) * gl_BaryCoordNV.y + getPosition(INBary[2].vidx) * gl_BaryCoordNV.z;
-  vec3 wPos = (mat4(object.worldMatrix) * vec4(oPos,1)).xyz;
+  vec3 wPos = (mat4(object.worldMatrix) * vec4(oPos,1)).xyz + copyOffset.xyz;
   
   vec3 oNormal = getNormal(INBary[0].vidx) * gl_BaryCoordNV.x + getNormal(INBary[1].vidx) * gl_BaryCoordNV.y + getNormal(INBary[2].vidx) * gl_BaryCoordNV.z;
   vec3 wNormal  = mat3(object.worldMatrixIT) * oNormal;
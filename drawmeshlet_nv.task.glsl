@@ -75,7 +75,7 @@ const uint TASK_MESHLET_ITERATIONS = ((NVMESHLET_PER_TASK + WORKGROUP_SIZE - 1)
   layout(push_constant) uniform pushConstant{
     // x: mesh, y: prim, z: 0, w: vertex
     uvec4     geometryOffsets;
-    // x: meshFirst, y: meshMax
+    // x: meshFirst, y: meshMax, z: partFirst, w: partLast
     uvec4     drawRange;
   };
 
@@ -89,6 +89,10 @@ const uint TASK_MESHLET_ITERATIONS = ((NVMESHLET_PER_TASK + WORKGROUP_SIZE - 1)
   layout(std140, binding= 0, set = DSET_OBJECT) uniform objectBuffer {
     ObjectData object;
   };
+
+  layout(std140, binding= 1, set = DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
   
   layout(std430, binding = GEOMETRY_SSBO_MESHLETDESC, set = DSET_GEOMETRY) buffer meshletDescBuffer {
     uvec4 meshletDescs[];
@@ -104,7 +108,7 @@ const uint TASK_MESHLET_ITERATIONS = ((NVMESHLET_PER_TASK + WORKGROUP_SIZE - 1)
 
   // x: mesh, y: prim, z: 0, w: vertex
   layout(location = 0) uniform uvec4 geometryOffsets;
-  // x: meshFirst, y: meshMax
+  // x: meshFirst, y: meshMax, z: partFirst, w: partLast
   layout(location = 1) uniform uvec4 drawRange;
 
   layout(std140, binding = UBO_SCENE_VIEW) uniform sceneBuffer {
@@ -118,6 +122,10 @@ const uint TASK_MESHLET_ITERATIONS = ((NVMESHLET_PER_TASK + WORKGROUP_SIZE - 1)
     ObjectData object;
   };
 
+  layout(std140, binding = UBO_COPY) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
   // keep in sync with binding order defined via GEOMETRY_
   layout(std140, binding = UBO_GEOMETRY) uniform geometryBuffer{
     uvec4*          meshletDescs;
@@ -152,6 +160,51 @@ taskNV out Task
 
 #include "nvmeshlet_utils.glsl"
 
+#if NVMESHLET_LOD
+uint getPrimWord(uint idx)
+{
+  return primIndices[idx / 2][idx % 2];
+}
+
+// draws of lod hierarchies only render the meshlets of the cut
+bool isMeshletLodDrawn(uvec4 desc)
+{
+  uint vertMax;
+  uint primMax;
+  uint primStart;
+  uint primDiv;
+  uint vidxStart;
+  uint vidxBits;
+  uint vidxDiv;
+  decodeMeshlet(desc, vertMax, primMax, primStart, primDiv, vidxStart, vidxBits, vidxDiv);
+
+  primStart += geometryOffsets.y / 4;
+
+  uint numStrips = 0;
+#if NVMESHLET_PRIMITIVE_STRIPS
+  for (uint w = 0; w < getMeshletStripRestartWords(primMax); w++) {
+    numStrips += bitCount(getPrimWord(primStart + w));
+  }
+#endif
+  uint primSize = getMeshletPrimSize(primMax, numStrips);
+
+  uint positionBits = 0;
+#if NVMESHLET_POSITION_BITS
+  positionBits = getPrimWord(getMeshletPositionStart(primStart, primSize) + 1) >> 16;
+#endif
+  uint lodStart = getMeshletPartStart(primStart, primSize, vertMax, positionBits);
+
+  vec4 bounds       = uintBitsToFloat(uvec4(getPrimWord(lodStart + 0), getPrimWord(lodStart + 1),
+                                            getPrimWord(lodStart + 2), getPrimWord(lodStart + 3)));
+  vec4 parentBounds = uintBitsToFloat(uvec4(getPrimWord(lodStart + 4), getPrimWord(lodStart + 5),
+                                            getPrimWord(lodStart + 6), getPrimWord(lodStart + 7)));
+  float error       = uintBitsToFloat(getPrimWord(lodStart + 8));
+  float parentError = uintBitsToFloat(getPrimWord(lodStart + 9));
+
+  return isMeshletLodSelected(bounds, parentBounds, error, parentError, object);
+}
+#endif
+
 /////////////////////////////////////////////////
 // EXECUTION
 
@@ -168,7 +221,11 @@ void main()
     uint  meshletGlobal = baseID + meshletLocal;
     uvec4 desc          = meshletDescs[min(meshletGlobal, drawRange.y) + geometryOffsets.x];
     
-    bool render = !(meshletGlobal > drawRange.y || earlyCull(desc, object));
+    // invalid descriptors pad parts to task boundaries
+    bool render = !(meshletGlobal > drawRange.y || !isMeshletValid(desc) || earlyCull(desc, object));
+  #if NVMESHLET_LOD
+    render = render && isMeshletLodDrawn(desc);
+  #endif
 
     uvec4 voteMeshlets = subgroupBallot(render);
     uint  numMeshlets  = subgroupBallotBitCount(voteMeshlets);
@@ -118,7 +118,7 @@ const uint MESHLET_PRIMITIVE_ITERATIONS = ((NVMESHLET_PRIMITIVE_COUNT + WORKGROU
   layout(push_constant) uniform pushConstant{
     // x: mesh, y: prim, z: 0, w: vertex
     uvec4     geometryOffsets;
-    // x: meshFirst, y: meshMax
+    // x: meshFirst, y: meshMax, z: partFirst, w: partLast
     uvec4     drawRange;
   };
 
@@ -133,6 +133,10 @@ const uint MESHLET_PRIMITIVE_ITERATIONS = ((NVMESHLET_PRIMITIVE_COUNT + WORKGROU
     ObjectData object;
   };
 
+  layout(std140, binding= 1, set = DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
   layout(std430, binding = GEOMETRY_SSBO_MESHLETDESC, set = DSET_GEOMETRY) buffer meshletDescBuffer {
     uvec4 meshletDescs[];
   };
@@ -150,7 +154,7 @@ const uint MESHLET_PRIMITIVE_ITERATIONS = ((NVMESHLET_PRIMITIVE_COUNT + WORKGROU
 
   // x: mesh, y: prim, z: 0, w: vertex
   layout(location = 0) uniform uvec4 geometryOffsets;
-  // x: meshFirst, y: meshMax
+  // x: meshFirst, y: meshMax, z: partFirst, w: partLast
   layout(location = 1) uniform uvec4 drawRange;
   
   layout(std140, binding = UBO_SCENE_VIEW) uniform sceneBuffer {
@@ -164,6 +168,10 @@ const uint MESHLET_PRIMITIVE_ITERATIONS = ((NVMESHLET_PRIMITIVE_COUNT + WORKGROU
     ObjectData object;
   };
 
+  layout(std140, binding = UBO_COPY) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
   // keep in sync with binding order defined via GEOMETRY_
   layout(std140, binding = UBO_GEOMETRY) uniform geometryBuffer{
     uvec4*          meshletDescs;
@@ -217,6 +225,68 @@ vec4 getExtra( uint vidx, uint xtra ){
   return texelFetch(texAbo, int(vidx * VERTEX_NORMAL_STRIDE + 1 + xtra));
 }
 
+#if NVMESHLET_POSITION_BITS
+// quantized positions stored within the meshlet pack,
+// set up in main()
+uint  meshletPositionStart;
+uvec4 meshletPositionHeader;
+uint  meshletVertMax;
+
+vec3 getMeshletPosition( uint vert ){
+  uint bits      = meshletPositionHeader.w;
+  uint bitOffset = min(vert, meshletVertMax) * 3 * bits;
+  uvec3 lattice;
+  UNROLL_LOOP
+  for (uint c = 0; c < 3; c++, bitOffset += bits) {
+    uint idx = (bitOffset >> 5) + meshletPositionStart + 2;
+    lattice[c] = decodeBits(primIndices1[idx], primIndices1[idx + 1], bitOffset & 31, bits);
+  }
+  return dequantizePosition(meshletPositionHeader.xyz + lattice, object);
+}
+#endif
+
+#if NVMESHLET_MERGED_PARTS
+// start of the meshlet's part ranges,
+// set up in main()
+uint meshletPartStart;
+
+// only primitives of the parts [drawRange.z, drawRange.w] are drawn
+bool isMeshletPrimitiveDrawn( uint prim ){
+  uint header    = primIndices1[meshletPartStart];
+  uint numRanges = header >> 24;
+  uint part      = header & 0xFFFFFF;
+  for (uint r = 0; r < numRanges; r++) {
+    uint range = primIndices1[meshletPartStart + 1 + r];
+    if (prim < (range >> 24)) break;
+    part = (header & 0xFFFFFF) + (range & 0xFFFFFF);
+  }
+  return part >= drawRange.z && part <= drawRange.w;
+}
+#endif
+
+#if NVMESHLET_PRIMITIVE_STRIPS
+// restart words and strip indices of the meshlet,
+// set up in main()
+uint meshletStripStart;
+uint meshletStripIndices;
+
+uint getMeshletStripByte( uint offset ){
+  return (primIndices1[offset / 4] >> ((offset % 4) * 8)) & 0xFF;
+}
+
+// the triangle's indices are the three strip bytes ending at its position
+uvec3 getMeshletStripPrimitive( uint prim ){
+  uint restartsBefore = 0;
+  for (uint w = 0; w < prim / 32; w++) {
+    restartsBefore += bitCount(primIndices1[meshletStripStart + w]);
+  }
+  uvec2 strip   = decodeStripPrimitive(prim, primIndices1[meshletStripStart + prim / 32], restartsBefore);
+  uint  offset  = meshletStripIndices + strip.x;
+  uvec3 indices = uvec3(getMeshletStripByte(offset - 2), getMeshletStripByte(offset - 1), getMeshletStripByte(offset));
+  return strip.y != 0 ? indices.yxz : indices;
+}
+#endif
+
 ////////////////////////////////////////////////////////////
 // OUTPUT
 
@@ -325,8 +395,12 @@ vec4 getExtra( uint vidx, uint xtra ){
 
 vec4 procVertex(const uint vert, uint vidx)
 {
+#if NVMESHLET_POSITION_BITS
+  vec3 oPos = getMeshletPosition(vert);
+#else
   vec3 oPos = getPosition(vidx);
-  vec3 wPos = (object.worldMatrix  * vec4(oPos,1)).xyz;
+#endif
+  vec3 wPos = (object.worldMatrix  * vec4(oPos,1)).xyz + copyOffset.xyz;
   vec4 hPos = (scene.viewProjMatrix * vec4(wPos,1));
 
   gl_MeshVerticesNV[vert].gl_Position = hPos;
@@ -390,11 +464,21 @@ void procAttributes(const uint vert, uint vidx)
 void main()
 {
 
-#if NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKBASIC
+#if NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKBASIC || NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKDELTA
 
   // LOAD HEADER PHASE
   uvec4 desc = meshletDescs[meshletID + geometryOffsets.x];
 
+#if !USE_TASK_STAGE
+  // skip padding between task aligned parts, the task stage already does
+  if (!isMeshletValid(desc)) {
+    if (laneID == 0) {
+      gl_PrimitiveCountNV = 0;
+    }
+    return;
+  }
+#endif
+
   uint vertMax;
   uint primMax;
 
@@ -409,6 +493,30 @@ void main()
   vidxStart += geometryOffsets.y / 4;
   primStart += geometryOffsets.y / 4;
 
+  uint numStrips = 0;
+#if NVMESHLET_PRIMITIVE_STRIPS
+  meshletStripStart   = primStart;
+  meshletStripIndices = (primStart + getMeshletStripRestartWords(primMax)) * 4;
+  for (uint w = 0; w < getMeshletStripRestartWords(primMax); w++) {
+    numStrips += bitCount(primIndices1[primStart + w]);
+  }
+#endif
+  uint primSize = getMeshletPrimSize(primMax, numStrips);
+
+#if NVMESHLET_POSITION_BITS
+  meshletPositionStart  = getMeshletPositionStart(primStart, primSize);
+  meshletPositionHeader = decodeMeshletPositionHeader(primIndices1[meshletPositionStart], primIndices1[meshletPositionStart + 1]);
+  meshletVertMax        = vertMax;
+#endif
+
+#if NVMESHLET_MERGED_PARTS
+  #if NVMESHLET_POSITION_BITS
+  meshletPartStart = getMeshletPartStart(primStart, primSize, vertMax, meshletPositionHeader.w);
+  #else
+  meshletPartStart = getMeshletPartStart(primStart, primSize, vertMax, 0);
+  #endif
+#endif
+
   uint primCount = primMax + 1;
   uint vertCount = vertMax + 1;
 
@@ -425,12 +533,22 @@ void main()
     #endif
 
       {
+      #if NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKDELTA
+        // base index followed by vidxBits wide deltas
+        uint bitOffset = vertLoad * vidxBits;
+        uint idx       = bitOffset >> 5;
+
+        uint vidx = primIndices1[vidxStart] + decodeBits(primIndices1[idx + vidxStart + 1],
+                                                         primIndices1[idx + vidxStart + 2],
+                                                         bitOffset & 31, vidxBits);
+      #else
         uint idx   = (vertLoad) >> (vidxDiv-1);
         uint shift = (vertLoad) & (vidxDiv-1);
 
         uint vidx = primIndices1[idx + vidxStart];
         vidx <<= vidxBits * (1-shift);
         vidx >>= vidxBits;
+      #endif
 
         vidx += geometryOffsets.w;
 
@@ -456,6 +574,22 @@ void main()
 
   // PRIMITIVE TOPOLOGY
   {
+#if NVMESHLET_PRIMITIVE_STRIPS
+    // strips are decoded per primitive, the culling below
+    // reads the indices back from gl_PrimitiveIndicesNV
+    
+    UNROLL_LOOP
+    for (uint i = 0; i < uint(MESHLET_PRIMITIVE_ITERATIONS); i++)
+    {
+      uint prim = laneID + i * WORKGROUP_SIZE;
+      if (prim <= primMax) {
+        uvec3 indices = getMeshletStripPrimitive(prim);
+        gl_PrimitiveIndicesNV[prim * 3 + 0] = indices.x;
+        gl_PrimitiveIndicesNV[prim * 3 + 1] = indices.y;
+        gl_PrimitiveIndicesNV[prim * 3 + 2] = indices.z;
+      }
+    }
+#else
     // To speed up loading of the primitive (triangle) indices
     // we load 64-bit per thread (NV hardware as fast paths
     // to load aligned 64- and 128-bit values).
@@ -482,6 +616,7 @@ void main()
       writePackedPrimitiveIndices4x8NV(readUsed * 8 + 0, topology.x);
       writePackedPrimitiveIndices4x8NV(readUsed * 8 + 4, topology.y);
     }
+#endif
   }
 
 #else
@@ -535,6 +670,9 @@ void main()
       // either by task-shader or indirect draws etc. (not used in this sample)
       primVisible = testTriangle(a.xy, b.xy, c.xy, 1.0, false);
     #endif
+    #if NVMESHLET_MERGED_PARTS
+      primVisible = primVisible && isMeshletPrimitiveDrawn(prim);
+    #endif
 
     #if USE_VERTEX_CULL
       if (primVisible) {
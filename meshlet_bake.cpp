@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) 2017-2022, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2017-2022 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+// Headless meshlet builder, loads a .csf/.gltf and builds the meshlet
+// topology like the sample does, without graphics api or window.
+// Prints timing and stats, verifies the meshlets and returns non-zero
+// if loading failed or any geometry did not pass the error check.
+// Options use the same names as the sample's parameters.
+// -meshletfuzz checks the builder on random meshes and -fp16bench times
+// the fp16 vertex conversion, both need no file.
+
+#include "cadscene.hpp"
+#include <nvh/nvprint.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static double getTimeMilliseconds()
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void printUsage()
+{
+  LOGI("usage: meshlet_bake [file.csf|file.gltf|file.csfbake] [options]\n")
+  LOGI("  -meshlet <vertices> <primitives>  meshlet limits (64 126)\n")
+  LOGI("  -meshletbuilder <0|1>             0 index order, 1 spatial\n")
+  LOGI("  -meshletencoding <0|1>            0 packbasic, 1 packdelta\n")
+  LOGI("  -meshletpositions <bits>          quantized positions, 0 disables\n")
+  LOGI("  -meshletcache <0|1>               use and write <file>.meshletcache\n")
+  LOGI("  -meshletmergeparts <0|1>          meshlets span consecutive parts\n")
+  LOGI("  -meshletlod <0|1>                 build lod hierarchies\n")
+  LOGI("  -meshletstrips <0|1>              store primitives as triangle strips\n")
+  LOGI("  -meshleterrorcheck <0|1>          verify meshlets against the indices (1), not for .csfbake\n")
+  LOGI("  -meshletstats <file>              write stats as JSON\n")
+  LOGI("  -savebaked <file>                 write the scene as .csfbake\n")
+  LOGI("  -meshletbench <0|1>               time the builder with common limits\n")
+  LOGI("  -meshlettune <0|1>                pick the best scoring limits\n")
+  LOGI("  -meshletfuzz <iterations>         check the builder on random meshes\n")
+  LOGI("  -meshletfuzzseed <seed>           first seed of the fuzz iterations (1)\n")
+  LOGI("  -taskpadding <0|1>                pad parts to task workgroups\n")
+  LOGI("  -tasknummeshlets <n>              meshlets per task workgroup (32)\n")
+  LOGI("  -vertexreorder <0|1>              optimize vertex order\n")
+  LOGI("  -vertexweld <0|1>                 weld vertices\n")
+  LOGI("  -vertexweldepsilon <epsilon>      weld grid cell size\n")
+  LOGI("  -fp16vertices <0|1>               fp16 vertex attributes\n")
+  LOGI("  -fp16bench <vertices>             time the fp16 conversion\n")
+  LOGI("  -mapfile <0|1>                    map the .csf, release geometry pages once converted\n")
+  LOGI("  -copies <n>                       scene copies\n")
+  LOGI("  -runs <n>                         load repeatedly, report the best time (1)\n")
+  LOGI("  -verbose <0|1>                    per geometry logging and stats (1)\n")
+}
+
+int main(int argc, const char** argv)
+{
+  const char* filename = nullptr;
+
+  CadScene::LoadConfig cfg;
+  cfg.meshletErrorCheck = true;
+
+  bool        benchmark       = false;
+  bool        tune            = false;
+  bool        taskPadding     = false;
+  uint32_t    numTaskMeshlets = 32;
+  int         copies          = 1;
+  int         runs            = 1;
+  uint32_t    fuzzIterations  = 0;
+  uint32_t    fuzzSeed        = 1;
+  uint32_t    fp16Vertices    = 0;
+  std::string statsFilename;
+  std::string bakedFilename;
+
+  for(int a = 1; a < argc; a++)
+  {
+    const char* arg     = argv[a];
+    int         numArgs = argc - a - 1;
+
+    if(arg[0] != '-' && !filename)
+    {
+      filename = arg;
+    }
+    else if(!strcmp(arg, "-meshlet"))
+    {
+      if(numArgs < 2)
+      {
+        LOGE("missing values for %s\n", arg)
+        printUsage();
+        return EXIT_FAILURE;
+      }
+      cfg.meshVertexCount    = uint32_t(atoi(argv[++a]));
+      cfg.meshPrimitiveCount = uint32_t(atoi(argv[++a]));
+    }
+    else if(numArgs < 1)
+    {
+      LOGE("missing value for %s\n", arg)
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    else if(!strcmp(arg, "-meshletbuilder"))
+      cfg.meshBuilder = MeshletBuilderType(atoi(argv[++a]));
+    else if(!strcmp(arg, "-meshletencoding"))
+      cfg.meshEncoding = uint32_t(atoi(argv[++a]));
+    else if(!strcmp(arg, "-meshletpositions"))
+      cfg.meshPositionBits = uint32_t(atoi(argv[++a]));
+    else if(!strcmp(arg, "-meshletcache"))
+      cfg.meshletCache = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshletmergeparts"))
+      cfg.meshletMergeParts = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshletlod"))
+      cfg.meshletLod = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshletstrips"))
+      cfg.meshletStrips = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshleterrorcheck"))
+      cfg.meshletErrorCheck = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshletstats"))
+      statsFilename = argv[++a];
+    else if(!strcmp(arg, "-savebaked"))
+      bakedFilename = argv[++a];
+    else if(!strcmp(arg, "-meshletbench"))
+      benchmark = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshlettune"))
+      tune = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-meshletfuzz"))
+      fuzzIterations = uint32_t(atoi(argv[++a]));
+    else if(!strcmp(arg, "-meshletfuzzseed"))
+      fuzzSeed = uint32_t(atoi(argv[++a]));
+    else if(!strcmp(arg, "-taskpadding"))
+      taskPadding = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-tasknummeshlets"))
+      numTaskMeshlets = uint32_t(atoi(argv[++a]));
+    else if(!strcmp(arg, "-vertexreorder"))
+      cfg.optimizeVertexOrder = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-vertexweld"))
+      cfg.weldVertices = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-vertexweldepsilon"))
+      cfg.weldEpsilon = float(atof(argv[++a]));
+    else if(!strcmp(arg, "-fp16vertices"))
+      cfg.fp16 = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-fp16bench"))
+      fp16Vertices = uint32_t(atoi(argv[++a]));
+    else if(!strcmp(arg, "-mapfile"))
+      cfg.mapFile = atoi(argv[++a]) != 0;
+    else if(!strcmp(arg, "-copies"))
+      copies = std::max(1, atoi(argv[++a]));
+    else if(!strcmp(arg, "-runs"))
+      runs = std::max(1, atoi(argv[++a]));
+    else if(!strcmp(arg, "-verbose"))
+      cfg.verbose = atoi(argv[++a]) != 0;
+    else
+    {
+      LOGE("unknown option %s\n", arg)
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  cfg.meshTaskPadding = taskPadding ? numTaskMeshlets : 0;
+
+  bool fuzzPassed = !fuzzIterations || CadScene::fuzzMeshletBuilder(fuzzIterations, fuzzSeed);
+  bool fp16Passed = !fp16Vertices || CadScene::benchmarkHalfConversion(fp16Vertices);
+  if(!filename)
+  {
+    if(!fuzzIterations && !fp16Vertices)
+    {
+      printUsage();
+    }
+    return (fuzzIterations || fp16Vertices) && fuzzPassed && fp16Passed ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  size_t filenameLength = strlen(filename);
+  bool   baked          = filenameLength >= 8 && !strcmp(filename + filenameLength - 8, ".csfbake");
+
+  if(benchmark && !baked && !CadScene::benchmarkMeshletBuilder(filename, cfg))
+  {
+    LOGE("could not load %s\n", filename)
+    return EXIT_FAILURE;
+  }
+
+  if(tune && !baked)
+  {
+    if(!CadScene::tuneMeshletLimits(filename, cfg, cfg.meshVertexCount, cfg.meshPrimitiveCount))
+    {
+      LOGE("could not load %s\n", filename)
+      return EXIT_FAILURE;
+    }
+    LOGI("meshlet tuning: using %d vertices, %d primitives\n", cfg.meshVertexCount, cfg.meshPrimitiveCount)
+  }
+
+  CadScene scene;
+  double   timeLoad = DBL_MAX;
+  for(int r = 0; r < runs; r++)
+  {
+    scene.unload();
+    scene = CadScene();
+
+    double timeBegin = getTimeMilliseconds();
+    bool loaded = baked ? scene.loadBaked(filename, cfg, copies - 1) : scene.loadCSF(filename, cfg, copies - 1);
+    if(!loaded)
+    {
+      LOGE("could not load %s\n", filename)
+      return EXIT_FAILURE;
+    }
+    timeLoad = std::min(timeLoad, getTimeMilliseconds() - timeBegin);
+
+    // later runs are only for timing
+    cfg.verbose = false;
+  }
+
+  size_t numMeshlets = 0;
+  for(const CadScene::Geometry& geom : scene.m_geometry)
+  {
+    numMeshlets += size_t(geom.meshlet.numMeshlets);
+  }
+
+  LOGI("meshlet bake: %s\n", filename)
+  LOGI("  load:        %9.2f ms (best of %d runs)\n", timeLoad, runs)
+  LOGI("  geometries:  %9zu\n", scene.m_geometry.size())
+  LOGI("  meshlets:    %9zu, %zu KB\n", numMeshlets, scene.m_meshSize / 1024)
+  LOGI("  vertices:    %9zu KB, indices %zu KB\n", scene.m_vboSize / 1024, scene.m_iboSize / 1024)
+  if(cfg.meshletErrorCheck && baked)
+  {
+    // baked meshlets are not rebuilt, so there is nothing to compare them against
+    LOGI("  error check:   skipped for baked input\n")
+  }
+  else if(cfg.meshletErrorCheck)
+  {
+    LOGI("  error check: %9d geometries failed\n", scene.m_meshletErrors)
+  }
+
+  if(!statsFilename.empty() && !scene.saveMeshletStats(statsFilename.c_str()))
+  {
+    LOGE("meshlet stats: could not write %s\n", statsFilename.c_str())
+    return EXIT_FAILURE;
+  }
+
+  if(!bakedFilename.empty() && !scene.saveBaked(bakedFilename.c_str()))
+  {
+    LOGE("baked scene: could not write %s\n", bakedFilename.c_str())
+    return EXIT_FAILURE;
+  }
+
+  return scene.m_meshletErrors || !fuzzPassed || !fp16Passed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
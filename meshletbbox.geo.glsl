@@ -40,6 +40,10 @@
     ObjectData object;
   };
 
+  layout(std140, binding = 1, set = DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
 #else
 
   layout(std140, binding = UBO_SCENE_VIEW) uniform sceneBuffer {
@@ -50,6 +54,10 @@
     ObjectData object;
   };
 
+  layout(std140, binding = UBO_COPY) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
 #endif
 
 /////////////////////////////////////////
@@ -94,6 +102,7 @@ void main()
   if (IN[0].meshletID == ~0u) return;
 
   mat4 worldTM  = object.worldMatrix;
+  worldTM[3].xyz += copyOffset.xyz;
   vec3 worldCtr = (worldTM * vec4(IN[0].bboxCtr, 1)).xyz;
   
   vec3 faceNormal = vec3(0);
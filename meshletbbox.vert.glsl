@@ -50,6 +50,10 @@
   layout(std140, binding= 0, set = DSET_OBJECT) uniform objectBuffer {
     ObjectData object;
   };
+
+  layout(std140, binding= 1, set = DSET_OBJECT) uniform copyBuffer {
+    vec4 copyOffset;
+  };
   
   layout(std430, binding = GEOMETRY_SSBO_MESHLETDESC, set = DSET_GEOMETRY) buffer meshletDescBuffer {
     uvec4 meshletDescs[];
@@ -74,6 +78,10 @@
     ObjectData object;
   };
 
+  layout(std140, binding = UBO_COPY) uniform copyBuffer {
+    vec4 copyOffset;
+  };
+
   // keep in sync with binding order defined via GEOMETRY_
   layout(std140, binding = UBO_GEOMETRY) uniform geometryBuffer{
     uvec4*          meshletDescs;
@@ -122,6 +130,8 @@ void main()
 #if SHOW_CULLED
   cull = !cull;
 #endif
+  // padding between task aligned parts
+  cull = cull || !isMeshletValid(meshlet);
   
   if (cull) {
     OUT.meshletID = ~0u;
@@ -46,6 +46,8 @@
 #include <nvh/geometry.hpp>
 #include <nvh/misc.hpp>
 
+#include <thread>
+
 #include "renderer.hpp"
 
 
@@ -163,7 +165,11 @@ class Sample
     GUI_SUPERSAMPLE,
     GUI_MESHLET_VERTICES,
     GUI_MESHLET_PRIMITIVES,
+    GUI_MESHLET_BUILDER,
+    GUI_MESHLET_ENCODING,
+    GUI_MESHLET_POSITIONS,
     GUI_TASK_MESHLETS,
+    GUI_STRATEGY,
     GUI_THREADS,
     GUI_MODEL,
   };
@@ -192,6 +198,7 @@ public:
     bool      showPrimIDs         = false;
     float     fov                 = 45.0f;
     float     pixelCull           = 0.5f;
+    float     lodPixelError       = 1.0f;
     int       renderer            = 0;
     int       viewPoint           = 0;
     int       supersample         = 2;
@@ -205,6 +212,8 @@ public:
     int32_t   indexThreshold      = 0;
     uint32_t  minTaskMeshlets     = 16;
     uint32_t  numTaskMeshlets     = 32;
+    bool      taskPadding         = false;
+    int       strategy            = RenderList::STRATEGY_SINGLE;
     vec3f     clipPosition        = vec3f(0.5f);
 #if IS_VULKAN
     bool     extLocalInvocationVertexOutput    = false;
@@ -250,12 +259,43 @@ public:
 
   bool                 m_firstConfig = true;
   bool                 m_customModel = false;
+  bool                 m_meshletBenchmark = false;
+  bool                 m_meshletTune      = false;
+  std::string          m_meshletStatsFilename;
+  std::string          m_bakedFilename;
   std::string          m_messageString;
   std::string          m_modelFilename;
   vec3f                m_modelUpVector = vec3f(0, 1, 0);
   CadScene::LoadConfig m_modelConfig;
   CadScene::LoadConfig m_lastModelConfig;
 
+  // everything initScene reads, copied on the main thread so that the loader
+  // thread does not race with the parameter list or benchmark steps
+  struct SceneRequest
+  {
+    std::string filename;
+    int         clones           = 0;
+    int         cloneaxis        = 0;
+    bool        meshletBenchmark = false;
+    bool        meshletTune      = false;
+    std::string meshletStatsFilename;
+    std::string bakedFilename;
+  };
+
+  // scene changes are loaded into m_sceneLoading by m_sceneLoader while m_scene keeps
+  // rendering, finishSceneLoad swaps them and uploads the new scene
+  bool                   m_asyncLoad     = true;
+  bool                   m_sceneLoadWait = false;
+  std::thread            m_sceneLoader;
+  std::atomic<bool>      m_sceneLoadDone{false};
+  bool                   m_sceneLoadValid        = false;
+  bool                   m_sceneLoadPending      = false;
+  bool                   m_sceneModelChanged     = false;
+  bool                   m_sceneLoadModelChanged = false;
+  CadScene               m_sceneLoading;
+  CadScene::LoadConfig   m_sceneLoadConfig;
+  CadScene::LoadProgress m_sceneLoadProgress;
+
 #if IS_VULKAN
   bool                                    m_supportsEXT = false;
   VkPhysicalDeviceMeshShaderPropertiesEXT m_meshPropertiesEXT = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT};
@@ -271,13 +311,18 @@ public:
   void setRendererFromName();
 
   bool initProgram();
-  bool initScene(const char* filename, int clones, int cloneaxis);
+  bool initScene(CadScene& scene, CadScene::LoadConfig& config, const SceneRequest& request);
   bool initFramebuffers(int width, int height);
   void initRenderer(int type);
 
   void loadDemoConfig();
+  void postSceneInit();
   void postSceneLoad();
 
+  SceneRequest getSceneRequest();
+  void         startSceneLoad();
+  void         finishSceneLoad();
+
   void deinitRenderer();
 
   void saveViewpoint();
@@ -287,6 +332,20 @@ public:
 
   std::string getShaderPrepend() const;
 
+  // merged parts do not get lod hierarchies, see CadScene::buildMeshletTopology
+  bool useMeshletLod() const
+  {
+    const CadScene::LoadConfig& cfg = m_scene.m_cfg;
+    return cfg.meshletLod && !(cfg.meshletMergeParts && cfg.meshBuilder == MESHLET_BUILDER_PACKBASIC);
+  }
+
+  // merged parts are not stored as strips either
+  bool useMeshletStrips() const
+  {
+    const CadScene::LoadConfig& cfg = m_scene.m_cfg;
+    return cfg.meshletStrips && !(cfg.meshletMergeParts && cfg.meshBuilder == MESHLET_BUILDER_PACKBASIC);
+  }
+
 #if IS_VULKAN
   void resetEXTtweaks()
   {
@@ -391,13 +450,6 @@ public:
     size_t offset = size_t(&val) - size_t(&m_tweak);
     return memcmp(&val, reinterpret_cast<const uint8_t*>(&m_lastTweak) + offset, sizeof(T)) != 0;
   }
-
-  template <typename T>
-  bool modelConfigChanged(const T& val) const
-  {
-    size_t offset = size_t(&val) - size_t(&m_modelConfig);
-    return memcmp(&val, reinterpret_cast<const uint8_t*>(&m_lastModelConfig) + offset, sizeof(T)) != 0;
-  }
 };
 
 std::string Sample::getShaderPrepend() const
@@ -415,12 +467,19 @@ std::string Sample::getShaderPrepend() const
     }
   }
 
-  prepend += nvh::stringFormat("#define NVMESHLET_VERTEX_COUNT %d\n", m_modelConfig.meshVertexCount)
-             + nvh::stringFormat("#define NVMESHLET_PRIMITIVE_COUNT %d\n", m_modelConfig.meshPrimitiveCount)
-             + nvh::stringFormat("#define NVMESHLET_ENCODING %d\n",
-                                 m_modelConfig.meshBuilder == MESHLET_BUILDER_PACKBASIC ? NVMESHLET_ENCODING_PACKBASIC : 0)
+  // the shaders are built for the scene that is rendered, see finishSceneLoad
+  const CadScene::LoadConfig& cfg = m_scene.m_cfg;
+
+  prepend += nvh::stringFormat("#define NVMESHLET_VERTEX_COUNT %d\n", cfg.meshVertexCount)
+             + nvh::stringFormat("#define NVMESHLET_PRIMITIVE_COUNT %d\n", cfg.meshPrimitiveCount)
+             + nvh::stringFormat("#define NVMESHLET_ENCODING %d\n", cfg.meshEncoding)
+             + nvh::stringFormat("#define NVMESHLET_POSITION_BITS %d\n", cfg.meshPositionBits)
+             + nvh::stringFormat("#define NVMESHLET_MERGED_PARTS %d\n",
+                                 cfg.meshletMergeParts && cfg.meshBuilder == MESHLET_BUILDER_PACKBASIC ? 1 : 0)
+             + nvh::stringFormat("#define NVMESHLET_LOD %d\n", useMeshletLod() ? 1 : 0)
+             + nvh::stringFormat("#define NVMESHLET_PRIMITIVE_STRIPS %d\n", useMeshletStrips() ? 1 : 0)
              + nvh::stringFormat("#define NVMESHLET_PER_TASK %d\n", m_tweak.numTaskMeshlets)
-             + nvh::stringFormat("#define VERTEX_EXTRAS_COUNT %d\n", m_modelConfig.extraAttributes)
+             + nvh::stringFormat("#define VERTEX_EXTRAS_COUNT %d\n", cfg.extraAttributes)
              + nvh::stringFormat("#define USE_VERTEX_CULL %d\n", m_tweak.useVertexCull ? 1 : 0)
              + nvh::stringFormat("#define USE_BARYCENTRIC_SHADING %d\n",
                                  m_tweak.useFragBarycentrics && m_supportsFragBarycentrics ? 1 : 0)
@@ -451,7 +510,7 @@ std::string Sample::getShaderPrepend() const
 
     uint32_t meshSubgroupSize = m_context.m_physicalInfo.properties11.subgroupSize;
     uint32_t meshSubgroupCount =
-        (std::min(std::max(m_modelConfig.meshVertexCount, m_modelConfig.meshPrimitiveCount), m_tweak.extMeshWorkGroupInvocations)
+        (std::min(std::max(cfg.meshVertexCount, cfg.meshPrimitiveCount), m_tweak.extMeshWorkGroupInvocations)
          + meshSubgroupSize - 1)
         / meshSubgroupSize;
 
@@ -478,11 +537,42 @@ bool Sample::initProgram()
   return true;
 }
 
-bool Sample::initScene(const char* filename, int clones, int cloneaxis)
+static bool endsWith(std::string const& s, std::string const& end)
 {
-  std::string modelFilename(filename);
+  if(s.length() >= end.length())
+  {
+    return (0 == s.compare(s.length() - end.length(), end.length(), end));
+  }
+  else
+  {
+    return false;
+  }
+}
+
+Sample::SceneRequest Sample::getSceneRequest()
+{
+  SceneRequest request;
+  request.filename             = m_modelFilename;
+  request.clones               = m_tweak.copies - 1;
+  request.cloneaxis            = (m_tweak.cloneaxisX << 0) | (m_tweak.cloneaxisY << 1) | (m_tweak.cloneaxisZ << 2);
+  request.meshletBenchmark     = m_meshletBenchmark;
+  request.meshletTune          = m_meshletTune;
+  request.meshletStatsFilename = m_meshletStatsFilename;
+  request.bakedFilename        = m_bakedFilename;
+
+  // the builder benchmark and tuning run once, for the next load
+  m_meshletBenchmark = false;
+  m_meshletTune      = false;
+
+  return request;
+}
 
-  if(!nvh::fileExists(filename))
+bool Sample::initScene(CadScene& scene, CadScene::LoadConfig& config, const SceneRequest& request)
+{
+  const std::string& filename = request.filename;
+  std::string        modelFilename(filename);
+
+  if(!nvh::fileExists(filename.c_str()))
   {
     modelFilename = nvh::getFileName(filename);
     std::vector<std::string> directories;
@@ -493,32 +583,80 @@ bool Sample::initScene(const char* filename, int clones, int cloneaxis)
     modelFilename = nvh::findFile(modelFilename, directories);
   }
 
-  m_scene.unload();
-  m_scene = CadScene();
+  bool baked = endsWith(modelFilename, ".csfbake");
+
+  if(request.meshletBenchmark && !baked)
+  {
+    CadScene::benchmarkMeshletBuilder(modelFilename.c_str(), config);
+  }
+
+  if(request.meshletTune && !baked)
+  {
+    // the shaders are built after the scene, so the tuned limits apply right away
+    uint32_t meshVertexCount;
+    uint32_t meshPrimitiveCount;
+    if(CadScene::tuneMeshletLimits(modelFilename.c_str(), config, meshVertexCount, meshPrimitiveCount))
+    {
+      LOGI("meshlet tuning: using %d vertices, %d primitives\n", meshVertexCount, meshPrimitiveCount)
+      config.meshVertexCount    = meshVertexCount;
+      config.meshPrimitiveCount = meshPrimitiveCount;
+    }
+  }
+
+  scene.unload();
 
-  bool status = m_scene.loadCSF(modelFilename.c_str(), m_modelConfig, clones, cloneaxis);
+  bool status = baked ? scene.loadBaked(modelFilename.c_str(), config, request.clones, request.cloneaxis) :
+                        scene.loadCSF(modelFilename.c_str(), config, request.clones, request.cloneaxis);
   if(status)
   {
-    LOGI("\nscene %s\n", filename)
-    LOGI("meshlet max vertex:     %2d\n", m_scene.m_cfg.meshVertexCount)
-    LOGI("meshlet max primitives: %2d\n", m_scene.m_cfg.meshPrimitiveCount)
-    LOGI("extra attributes:       %2d\n", m_scene.m_cfg.extraAttributes)
-    LOGI("allow short indices:    %2d\n", m_scene.m_cfg.allowShorts ? 1 : 0)
-    LOGI("use fp16 vertices:      %2d\n", m_scene.m_cfg.fp16 ? 1 : 0)
-    LOGI("geometries: %9d\n", uint32_t(m_scene.m_geometry.size()))
-    LOGI("materials:  %9d\n", uint32_t(m_scene.m_materials.size()))
-    LOGI("nodes:      %9d\n", uint32_t(m_scene.m_matrices.size()))
-    LOGI("objects:    %9d\n", uint32_t(m_scene.m_objects.size()))
+    if(baked)
+    {
+      // the baked data dictates the vertex and meshlet layout the shaders are built for
+      config = scene.m_cfg;
+    }
+
+    LOGI("\nscene %s\n", filename.c_str())
+    LOGI("meshlet max vertex:     %2d\n", scene.m_cfg.meshVertexCount)
+    LOGI("meshlet max primitives: %2d\n", scene.m_cfg.meshPrimitiveCount)
+    LOGI("extra attributes:       %2d\n", scene.m_cfg.extraAttributes)
+    LOGI("allow short indices:    %2d\n", scene.m_cfg.allowShorts ? 1 : 0)
+    LOGI("use fp16 vertices:      %2d\n", scene.m_cfg.fp16 ? 1 : 0)
+    LOGI("geometries: %9d\n", uint32_t(scene.m_geometry.size()))
+    LOGI("materials:  %9d\n", uint32_t(scene.m_materials.size()))
+    LOGI("nodes:      %9d\n", uint32_t(scene.m_matrices.size()))
+    LOGI("objects:    %9d\n", uint32_t(scene.getNumInstancedObjects()))
+    LOGI("copies:     %9d\n", uint32_t(scene.getNumCopies()))
     LOGI("\n")
+
+    if(!request.meshletStatsFilename.empty())
+    {
+      if(scene.saveMeshletStats(request.meshletStatsFilename.c_str()))
+      {
+        LOGI("meshlet stats: written to %s\n", request.meshletStatsFilename.c_str())
+      }
+      else
+      {
+        LOGE("meshlet stats: could not write %s\n", request.meshletStatsFilename.c_str())
+      }
+    }
+
+    if(!request.bakedFilename.empty())
+    {
+      if(scene.saveBaked(request.bakedFilename.c_str()))
+      {
+        LOGI("baked scene: written to %s\n", request.bakedFilename.c_str())
+      }
+      else
+      {
+        LOGE("baked scene: could not write %s\n", request.bakedFilename.c_str())
+      }
+    }
   }
   else
   {
     LOGW("\ncould not load model %s\n", modelFilename.c_str())
   }
 
-  //if (m_tweak.objectNum == ~0) {
-  m_tweak.objectNum = (uint32_t)m_scene.m_objects.size();
-  //}
   return status;
 }
 
@@ -554,7 +692,7 @@ void Sample::initRenderer(int typesort)
     m_resources                    = Renderer::getRegistry()[type]->resources();
     m_resources->m_cullBackFace    = m_tweak.useBackFaceCull;
     m_resources->m_clipping        = m_tweak.useClipping;
-    m_resources->m_extraAttributes = m_modelConfig.extraAttributes;
+    m_resources->m_extraAttributes = m_scene.m_cfg.extraAttributes;
 #if IS_OPENGL
     bool valid = m_resources->init(&m_contextWindow, &m_profiler);
 #elif IS_VULKAN
@@ -582,7 +720,8 @@ void Sample::initRenderer(int typesort)
     config.taskMinMeshlets = m_tweak.minTaskMeshlets;
     config.taskNumMeshlets = m_tweak.numTaskMeshlets;
     config.indexThreshold  = m_tweak.indexThreshold;
-    config.strategy        = RenderList::STRATEGY_SINGLE;
+    config.strategy        = RenderList::Strategy(m_tweak.strategy);
+    config.meshletLod      = useMeshletLod();
 
     m_renderList.setup(&m_scene, config);
   }
@@ -636,6 +775,21 @@ void Sample::loadViewpoints()
   }
 }
 
+void Sample::postSceneInit()
+{
+  if(endsWith(m_modelFilename, ".csfbake"))
+  {
+    // the baked meshlets were padded for this many meshlets per task
+    m_tweak.taskPadding = m_scene.m_cfg.meshTaskPadding != 0;
+    if(m_tweak.taskPadding)
+    {
+      m_tweak.numTaskMeshlets = m_scene.m_cfg.meshTaskPadding;
+    }
+  }
+
+  m_tweak.objectNum = (uint32_t)m_scene.getNumInstancedObjects();
+}
+
 void Sample::postSceneLoad()
 {
   loadViewpoints();
@@ -671,6 +825,72 @@ void Sample::postSceneLoad()
   }
 }
 
+void Sample::startSceneLoad()
+{
+  SceneRequest request = getSceneRequest();
+
+  m_sceneLoadConfig       = m_modelConfig;
+  m_sceneLoadModelChanged = m_sceneModelChanged;
+  m_sceneModelChanged     = false;
+  m_sceneLoadPending      = false;
+  m_sceneLoadDone         = false;
+
+  m_sceneLoadProgress.reset();
+  m_sceneLoading            = CadScene();
+  m_sceneLoading.m_progress = &m_sceneLoadProgress;
+
+  // the loader thread only touches its request copy, m_sceneLoading, m_sceneLoadConfig,
+  // m_sceneLoadProgress and m_sceneLoadValid until m_sceneLoadDone is set
+  m_sceneLoader = std::thread([this, request]() {
+    m_sceneLoadValid = initScene(m_sceneLoading, m_sceneLoadConfig, request);
+    m_sceneLoadDone  = true;
+  });
+}
+
+void Sample::finishSceneLoad()
+{
+  m_sceneLoader.join();
+
+  if(!m_sceneLoadValid)
+  {
+    LOGE("Loading scene failed\n")
+    exit(-1);
+  }
+
+  // GL contexts are bound to the main thread and vulkan submits on the app's queue,
+  // so the upload happens here rather than on the loader thread
+  m_resources->synchronize();
+  deinitRenderer();
+  m_resources->deinitScene();
+
+  bool configChanged = memcmp(&m_scene.m_cfg, &m_sceneLoading.m_cfg, sizeof(CadScene::LoadConfig)) != 0;
+
+  std::swap(m_scene, m_sceneLoading);
+  m_sceneLoading.unload();
+  m_scene.m_progress = nullptr;
+
+  // baked or tuned scenes replace the requested config with their own,
+  // unless another change was requested meanwhile
+  if(!m_sceneLoadPending)
+  {
+    m_modelConfig = m_sceneLoadConfig;
+  }
+
+  postSceneInit();
+
+  if(configChanged)
+  {
+    m_resources->reloadPrograms(getShaderPrepend());
+  }
+
+  if(m_sceneLoadModelChanged)
+  {
+    postSceneLoad();
+  }
+
+  m_resources->initScene(m_scene);
+}
+
 bool Sample::begin()
 {
 #if IS_OPENGL
@@ -786,6 +1006,10 @@ bool Sample::begin()
     m_ui.enumAdd(GUI_TASK_MESHLETS, 96, "96");
     m_ui.enumAdd(GUI_TASK_MESHLETS, 128, "128");
 
+    m_ui.enumAdd(GUI_STRATEGY, RenderList::STRATEGY_SINGLE, "per object");
+    m_ui.enumAdd(GUI_STRATEGY, RenderList::STRATEGY_INDIVIDUAL, "per part");
+    m_ui.enumAdd(GUI_STRATEGY, RenderList::STRATEGY_JOIN, "joined parts");
+
     // the 40,84,126 are tuned for the allocation granularity
     m_ui.enumAdd(GUI_MESHLET_PRIMITIVES, 32, "32");
     m_ui.enumAdd(GUI_MESHLET_PRIMITIVES, 40, "40");
@@ -795,6 +1019,16 @@ bool Sample::begin()
     m_ui.enumAdd(GUI_MESHLET_PRIMITIVES, 126, "126");
     m_ui.enumAdd(GUI_MESHLET_PRIMITIVES, 128, "128");
 
+    m_ui.enumAdd(GUI_MESHLET_BUILDER, MESHLET_BUILDER_PACKBASIC, "index order");
+    m_ui.enumAdd(GUI_MESHLET_BUILDER, MESHLET_BUILDER_SPATIAL, "spatial");
+
+    m_ui.enumAdd(GUI_MESHLET_ENCODING, NVMESHLET_ENCODING_PACKBASIC, "16/32-bit indices");
+    m_ui.enumAdd(GUI_MESHLET_ENCODING, NVMESHLET_ENCODING_PACKDELTA, "delta indices");
+
+    m_ui.enumAdd(GUI_MESHLET_POSITIONS, 0, "vertex buffer");
+    m_ui.enumAdd(GUI_MESHLET_POSITIONS, 12, "12-bit quantized");
+    m_ui.enumAdd(GUI_MESHLET_POSITIONS, 16, "16-bit quantized");
+
     m_ui.enumAdd(GUI_THREADS, 32, "32");
     m_ui.enumAdd(GUI_THREADS, 64, "64");
     m_ui.enumAdd(GUI_THREADS, 96, "96");
@@ -809,10 +1043,11 @@ bool Sample::begin()
     loadDemoConfig();
   }
 
-  validated = validated
-              && initScene(m_modelFilename.c_str(), m_tweak.copies - 1,
-                           (m_tweak.cloneaxisX << 0) | (m_tweak.cloneaxisY << 1) | (m_tweak.cloneaxisZ << 2));
+  m_modelConfig.meshTaskPadding = m_tweak.taskPadding ? m_tweak.numTaskMeshlets : 0;
+
+  validated = validated && initScene(m_scene, m_modelConfig, getSceneRequest());
 
+  postSceneInit();
   postSceneLoad();
 
   initRenderer(m_tweak.renderer);
@@ -827,6 +1062,11 @@ bool Sample::begin()
 
 void Sample::end()
 {
+  if(m_sceneLoader.joinable())
+  {
+    m_sceneLoader.join();
+  }
+
   deinitRenderer();
   if(m_resources)
   {
@@ -866,7 +1106,16 @@ void Sample::processUI(int width, int height, double time)
     {
       m_ui.enumCombobox(GUI_MESHLET_VERTICES, "meshlet vertices", &m_modelConfig.meshVertexCount);
       m_ui.enumCombobox(GUI_MESHLET_PRIMITIVES, "meshlet primitives", &m_modelConfig.meshPrimitiveCount);
+      m_ui.enumCombobox(GUI_MESHLET_BUILDER, "meshlet builder", &m_modelConfig.meshBuilder);
+      m_ui.enumCombobox(GUI_MESHLET_ENCODING, "meshlet encoding", &m_modelConfig.meshEncoding);
+      m_ui.enumCombobox(GUI_MESHLET_POSITIONS, "meshlet positions", &m_modelConfig.meshPositionBits);
+      ImGui::Checkbox("meshlets span parts", &m_modelConfig.meshletMergeParts);
+      ImGui::Checkbox("meshlet lod", &m_modelConfig.meshletLod);
+      ImGui::Checkbox("meshlet strips", &m_modelConfig.meshletStrips);
+      ImGui::SliderFloat("lod pixel error", &m_tweak.lodPixelError, 0.25f, 16.0f, "%.2f");
       m_ui.enumCombobox(GUI_TASK_MESHLETS, "task meshlet count", &m_tweak.numTaskMeshlets);
+      ImGui::Checkbox("task aligned parts", &m_tweak.taskPadding);
+      m_ui.enumCombobox(GUI_STRATEGY, "draw strategy", &m_tweak.strategy);
       ImGuiH::InputIntClamped("task min. meshlets\n0 disables task stage", &m_tweak.minTaskMeshlets, 0, 256, 1, 16,
                               ImGuiInputTextFlags_EnterReturnsTrue);
       ImGui::SliderFloat("task pixel cull", &m_tweak.pixelCull, 0.0f, 1.0f, "%.2f");
@@ -908,8 +1157,8 @@ void Sample::processUI(int width, int height, double time)
 
 #if 0
       ImGui::Separator();
-      ImGuiH::InputIntClamped("objectFrom", &m_tweak.objectFrom, 0, (int)m_scene.m_objects.size()-1);
-      ImGuiH::InputIntClamped("objectNum", &m_tweak.objectNum, 0, (int)m_scene.m_objects.size());
+      ImGuiH::InputIntClamped("objectFrom", &m_tweak.objectFrom, 0, (int)m_scene.getNumInstancedObjects()-1);
+      ImGuiH::InputIntClamped("objectNum", &m_tweak.objectNum, 0, (int)m_scene.getNumInstancedObjects());
       ImGui::InputInt("indexThreshold", &m_tweak.indexThreshold);
 #endif
     }
@@ -950,6 +1199,13 @@ void Sample::processUI(int width, int height, double time)
         ImGui::Text("         Render GPU [ms]: %2.3f", gpuTimeF / 1000.0f);
         ImGui::Text("Original Index Size [MB]: %4zu", m_scene.m_iboSize / (1024 * 1024));
         ImGui::Text("       Meshlet Size [MB]: %4zu", m_scene.m_meshSize / (1024 * 1024));
+        if(m_sceneLoader.joinable())
+        {
+          ImGui::Text("      Loading Geometries: %u / %u", m_sceneLoadProgress.geometries.load(),
+                      m_sceneLoadProgress.numGeometries.load());
+          ImGui::Text("        Loading Meshlets: %u / %u", m_sceneLoadProgress.meshletSteps.load(),
+                      m_sceneLoadProgress.numMeshletSteps.load());
+        }
       }
     }
 
@@ -972,6 +1228,8 @@ void Sample::processUI(int width, int height, double time)
     if(ImGui::CollapsingHeader("Model Settings"))
     {
       ImGui::Checkbox("use fp16 vtx attribs", &m_modelConfig.fp16);
+      ImGui::Checkbox("reorder vertices", &m_modelConfig.optimizeVertexOrder);
+      ImGui::Checkbox("weld vertices", &m_modelConfig.weldVertices);
       ImGuiH::InputIntClamped("extra vec4 attribs", &m_modelConfig.extraAttributes, 0, 7);
       ImGuiH::InputIntClamped("model copies", &m_tweak.copies, 1, 256, 1, 10, ImGuiInputTextFlags_EnterReturnsTrue);
     }
@@ -1015,6 +1273,9 @@ void Sample::think(double time)
                            nvmath::vec2f(m_windowState.m_mouseCurrent[0], m_windowState.m_mouseCurrent[1]),
                            m_windowState.m_mouseButtonFlags, m_windowState.m_mouseWheel);
 
+  // padding depends on the task shader's meshlets
+  m_modelConfig.meshTaskPadding = m_tweak.taskPadding ? m_tweak.numTaskMeshlets : 0;
+
   bool modelChanged = false;
   if(!m_customModel && tweakChanged(m_tweak.demoScene))
   {
@@ -1022,7 +1283,7 @@ void Sample::think(double time)
     loadDemoConfig();
   }
 
-  // trigger recompile of shaders
+  // trigger recompile of shaders, model config changes recompile in finishSceneLoad
   if(m_windowState.onPress(KEY_R) || tweakChanged(m_tweak.useBackFaceCull) || tweakChanged(m_tweak.useClipping)
      || tweakChanged(m_tweak.useStats) || tweakChanged(m_tweak.showBboxes) || tweakChanged(m_tweak.showNormals)
      || tweakChanged(m_tweak.showCulled) || tweakChanged(m_tweak.showPrimIDs) || tweakChanged(m_tweak.numTaskMeshlets)
@@ -1032,8 +1293,7 @@ void Sample::think(double time)
      || tweakChanged(m_tweak.extCompactPrimitiveOutput) || tweakChanged(m_tweak.extCompactVertexOutput)
      || tweakChanged(m_tweak.extLocalInvocationPrimitiveOutput) || tweakChanged(m_tweak.extLocalInvocationVertexOutput)
 #endif
-     || modelConfigChanged(m_modelConfig.extraAttributes) || modelConfigChanged(m_modelConfig.meshPrimitiveCount)
-     || modelConfigChanged(m_modelConfig.meshVertexCount) || m_shaderprepend != m_lastShaderPrepend)
+     || m_shaderprepend != m_lastShaderPrepend)
 
   {
     m_resources->synchronize();
@@ -1052,34 +1312,41 @@ void Sample::think(double time)
     m_resources->initFramebuffer(width, height, m_tweak.supersample, getVsync());
   }
 
-  bool sceneChanged = false;
   if(modelChanged || tweakChanged(m_tweak.copies) || tweakChanged(m_tweak.cloneaxisX) || tweakChanged(m_tweak.cloneaxisY)
      || tweakChanged(m_tweak.cloneaxisZ) || memcmp(&m_modelConfig, &m_lastModelConfig, sizeof(m_modelConfig)))
   {
+    m_sceneLoadPending  = true;
+    m_sceneModelChanged = m_sceneModelChanged || modelChanged;
+  }
+
+  bool sceneChanged = false;
+  bool sceneWait    = !m_asyncLoad || m_sceneLoadWait;
+  m_sceneLoadWait   = false;
+
+  // a queued change must not wait behind a running load when the frame needs the result
+  if(sceneWait && m_sceneLoadPending && m_sceneLoader.joinable())
+  {
+    finishSceneLoad();
     sceneChanged = true;
-    m_resources->synchronize();
-    deinitRenderer();
-    m_resources->deinitScene();
-    bool validated = initScene(m_modelFilename.c_str(), m_tweak.copies - 1,
-                               (m_tweak.cloneaxisX << 0) | (m_tweak.cloneaxisY << 1) | (m_tweak.cloneaxisZ << 2));
+  }
 
-    if(modelChanged)
-    {
-      postSceneLoad();
-    }
+  // one load at a time, changes made while loading queue up the next one
+  if(m_sceneLoadPending && !m_sceneLoader.joinable())
+  {
+    startSceneLoad();
+  }
 
-    if(!validated)
-    {
-      LOGE("Loading scene failed\n")
-      exit(-1);
-    }
-    m_resources->initScene(m_scene);
+  if(m_sceneLoader.joinable() && (m_sceneLoadDone || sceneWait))
+  {
+    finishSceneLoad();
+    sceneChanged = true;
   }
 
   if(sceneChanged || tweakChanged(m_tweak.renderer) || tweakChanged(m_tweak.objectFrom)
      || tweakChanged(m_tweak.objectNum) || tweakChanged(m_tweak.useClipping) || tweakChanged(m_tweak.useStats)
      || tweakChanged(m_tweak.maxGroups) || tweakChanged(m_tweak.indexThreshold) || tweakChanged(m_tweak.minTaskMeshlets)
-     || tweakChanged(m_tweak.usePrimitiveCull) || tweakChanged(m_tweak.numTaskMeshlets))
+     || tweakChanged(m_tweak.usePrimitiveCull) || tweakChanged(m_tweak.numTaskMeshlets)
+     || tweakChanged(m_tweak.strategy))
   {
     m_resources->synchronize();
     initRenderer(m_tweak.renderer);
@@ -1103,6 +1370,8 @@ void Sample::think(double time)
     sceneUbo.viewportf        = vec2(width * m_tweak.supersample, height * m_tweak.supersample);
     sceneUbo.viewportTaskCull = sceneUbo.viewportf * m_tweak.pixelCull;
     sceneUbo.colorize         = m_tweak.colorize ? 1 : 0;
+    // object space error to pixels at unit distance, relative to the allowed error
+    sceneUbo.lodErrorScale = float(height) / (2.0f * tanf(m_tweak.fov * 0.5f * nvmath::nv_pi / 180.0f)) / m_tweak.lodPixelError;
 
     if(m_tweak.animate)
     {
@@ -1184,6 +1453,8 @@ void Sample::resize(int width, int height)
 void Sample::postBenchmarkAdvance()
 {
   setRendererFromName();
+  // the frames after a benchmark step must render the scene it configured
+  m_sceneLoadWait = true;
 }
 
 void Sample::saveViewpoint()
@@ -1234,23 +1505,12 @@ static std::string addPath(std::string const& defaultPath, std::string const& fi
   }
 }
 
-static bool endsWith(std::string const& s, std::string const& end)
-{
-  if(s.length() >= end.length())
-  {
-    return (0 == s.compare(s.length() - end.length(), end.length(), end));
-  }
-  else
-  {
-    return false;
-  }
-}
-
 void Sample::setupConfigParameters()
 {
   m_parameterList.addFilename(".csf", &m_modelFilename);
   m_parameterList.addFilename(".csf.gz", &m_modelFilename);
   m_parameterList.addFilename(".gltf", &m_modelFilename);
+  m_parameterList.addFilename(".csfbake", &m_modelFilename);
 
   m_parameterList.add("vkdevice", &Resources::s_vkDevice);
   m_parameterList.add("gldevice", &Resources::s_glDevice);
@@ -1276,6 +1536,11 @@ void Sample::setupConfigParameters()
   m_parameterList.add("fp16vertices", &m_modelConfig.fp16);
   m_parameterList.add("extraattributes", &m_modelConfig.extraAttributes);
   m_parameterList.add("colorizeextra", &m_modelConfig.colorizeExtra);
+  m_parameterList.add("vertexreorder", &m_modelConfig.optimizeVertexOrder);
+  m_parameterList.add("vertexweld", &m_modelConfig.weldVertices);
+  m_parameterList.add("vertexweldepsilon", &m_modelConfig.weldEpsilon);
+  m_parameterList.add("mapfile", &m_modelConfig.mapFile);
+  m_parameterList.add("asyncload", &m_asyncLoad);
 
   m_parameterList.add("objectfirst", &m_tweak.objectFrom);
   m_parameterList.add("objectnum", &m_tweak.objectNum);
@@ -1283,11 +1548,25 @@ void Sample::setupConfigParameters()
   m_parameterList.add("indexthreshold", &m_tweak.indexThreshold);
   m_parameterList.add("taskminmeshlets", &m_tweak.minTaskMeshlets);
   m_parameterList.add("tasknummeshlets", &m_tweak.numTaskMeshlets);
+  m_parameterList.add("taskpadding", &m_tweak.taskPadding);
+  m_parameterList.add("strategy", &m_tweak.strategy);
   m_parameterList.add("taskpixelcull", &m_tweak.pixelCull);
+  m_parameterList.add("meshletlod", &m_modelConfig.meshletLod);
+  m_parameterList.add("lodpixelerror", &m_tweak.lodPixelError);
 
   m_parameterList.add("shaderprepend", &m_shaderprepend);
 
   m_parameterList.add("meshlet", &m_modelConfig.meshVertexCount, nullptr, 2);
+  m_parameterList.add("meshletbuilder", (uint32_t*)&m_modelConfig.meshBuilder);
+  m_parameterList.add("meshletencoding", &m_modelConfig.meshEncoding);
+  m_parameterList.add("meshletpositions", &m_modelConfig.meshPositionBits);
+  m_parameterList.add("meshletcache", &m_modelConfig.meshletCache);
+  m_parameterList.add("meshletmergeparts", &m_modelConfig.meshletMergeParts);
+  m_parameterList.add("meshletstrips", &m_modelConfig.meshletStrips);
+  m_parameterList.add("meshletbench", &m_meshletBenchmark);
+  m_parameterList.add("meshlettune", &m_meshletTune);
+  m_parameterList.add("meshletstats", &m_meshletStatsFilename);
+  m_parameterList.add("savebaked", &m_bakedFilename);
   m_parameterList.add("primitivecull", &m_tweak.usePrimitiveCull);
   m_parameterList.add("vertexcull", &m_tweak.useVertexCull);
   m_parameterList.add("backfacecull", &m_tweak.useBackFaceCull);
@@ -1380,8 +1659,6 @@ using namespace meshlettest;
 #include <omp.h>
 #endif
 
-#include <thread>
-
 int main(int argc, const char** argv)
 {
   NVPSystem system(EXE_NAME);
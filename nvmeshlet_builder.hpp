@@ -26,11 +26,25 @@
 #include <cstdint>
 #include <vector>
 #include <stdio.h>
+#include <string.h>
 
 #ifdef _MSC_VER
 #include <intrin.h>
 #endif
 
+#if defined(__AVX2__)
+#define NVMESHLET_CACHE_AVX2 1
+#define NVMESHLET_CACHE_SSE2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NVMESHLET_CACHE_AVX2 0
+#define NVMESHLET_CACHE_SSE2 1
+#include <emmintrin.h>
+#else
+#define NVMESHLET_CACHE_AVX2 0
+#define NVMESHLET_CACHE_SSE2 0
+#endif
+
 namespace NVMeshlet {
 // Each Meshlet can have a varying count of its maximum number
 // of vertices and primitives. We hardcode a few absolute maxima
@@ -132,6 +146,8 @@ struct Stats
     vertexTotal += other.vertexTotal;
     primTotal += other.primTotal;
 
+    posBitTotal += other.posBitTotal;
+
     appended += other.appended;
     primloadAvg += other.primloadAvg;
     primloadVar += other.primloadVar;
@@ -139,7 +155,37 @@ struct Stats
     vertexloadVar += other.vertexloadVar;
   }
 
-  void fprint(FILE* log) const
+  // average fraction of the vertex and primitive limits the meshlets use
+  double getFill() const
+  {
+    return appended ? (primloadAvg + vertexloadAvg) / double(appended * 2) : 0.0;
+  }
+
+  // storage overhead of the index packing and padded meshlets
+  double getWaste() const
+  {
+    if(!meshletsTotal)
+      return 0.0;
+
+    double primWaste    = double(primIndices) / double(primTotal * 3) - 1.0;
+    double vertexWaste  = double(vertexIndices) / double(vertexTotal) - 1.0;
+    double meshletWaste = double(meshletsStored) / double(meshletsTotal) - 1.0;
+    return primWaste + vertexWaste + meshletWaste;
+  }
+
+  // Figure of merit to compare builds with different limits, higher is better.
+  // Triangles per meshlet vertex (vertex reuse) scaled by the fill, as the
+  // hardware allocates outputs for the limits, and by the storage overhead.
+  double getScore() const
+  {
+    if(!meshletsTotal)
+      return 0.0;
+
+    return getFill() * double(primTotal) / (double(vertexTotal) * (1.0 + getWaste()));
+  }
+
+  // optionally compares against stats of another builder run on the same data
+  void fprint(FILE* log, const Stats* reference = nullptr) const
   {
     if(!appended || !meshletsTotal)
       return;
@@ -156,6 +202,67 @@ struct Stats
 
     fprintf(log, "meshlets; %7zd; prim; %9zd; %.2f; vertex; %9zd; %.2f; backface; %.2f; waste; v; %.2f; p; %.2f; m; %.2f;\n",
             meshletsTotal, primTotal, fprimloadAvg, vertexTotal, fvertexloadAvg, backfaceAvg, vertexWaste, primWaste, meshletWaste);
+
+    fprintf(log, "load variance; prim; %.4f; vertex; %.4f;\n", primloadVar / double(appended), vertexloadVar / double(appended));
+
+    if(posBitTotal)
+    {
+      // compared to 3 x fp32 per vertex
+      double posBitsAvg = double(posBitTotal) / double(vertexTotal);
+      fprintf(log, "positions; bits per vertex; %.2f; ratio; %.2f;\n", posBitsAvg, posBitsAvg / 96.0);
+    }
+
+    if(reference && reference->appended && reference->meshletsTotal)
+    {
+      double refBackfaceAvg = double(reference->backfaceTotal) / double(reference->meshletsTotal);
+      double meshletsDiff   = double(meshletsTotal) / double(reference->meshletsTotal) - 1.0;
+
+      fprintf(log, "reference; meshlets; %7zd; backface; %.2f; diff; meshlets; %+.2f; backface; %+.2f;\n",
+              reference->meshletsTotal, refBackfaceAvg, meshletsDiff, backfaceAvg - refBackfaceAvg);
+    }
+  }
+
+  // same values as fprint as a single JSON object
+  void fprintJson(FILE* log) const
+  {
+    double statsNum    = appended ? double(appended) : 1.0;
+    double meshletsNum = meshletsTotal ? double(meshletsTotal) : 1.0;
+
+    fprintf(log, "{\"meshlets\": %zu, \"meshletsStored\": %zu, \"primitives\": %zu, \"vertices\": %zu, ", meshletsTotal,
+            meshletsStored, primTotal, vertexTotal);
+    fprintf(log, "\"primLoadAvg\": %.4f, \"primLoadVar\": %.4f, \"vertexLoadAvg\": %.4f, \"vertexLoadVar\": %.4f, ",
+            primloadAvg / statsNum, primloadVar / statsNum, vertexloadAvg / statsNum, vertexloadVar / statsNum);
+    fprintf(log, "\"backface\": %.4f, \"waste\": %.4f, \"posBitsPerVertex\": %.2f, \"score\": %.4f}",
+            double(backfaceTotal) / meshletsNum, getWaste(), vertexTotal ? double(posBitTotal) / double(vertexTotal) : 0.0,
+            getScore());
+  }
+};
+
+// Distributions over the meshlets that complement the sums and averages
+// of Stats, padding meshlets are skipped as well.
+
+struct StatsHistograms
+{
+  // meshlets per vertex and per primitive count
+  size_t vertices[MAX_VERTEX_COUNT_LIMIT + 1]     = {};
+  size_t primitives[MAX_PRIMITIVE_COUNT_LIMIT + 1] = {};
+  // meshlets per cone angle, -sin(cone.angle) as SNORM8 offset by 128,
+  // 127 + 128 means no backface culling
+  size_t cones[256] = {};
+  // meshlets per largest bbox extent, in units of the 8 bit grid
+  // spanning the object's bbox
+  size_t bboxExtents[256] = {};
+
+  void append(const StatsHistograms& other)
+  {
+    for(size_t i = 0; i < sizeof(vertices) / sizeof(vertices[0]); i++)
+      vertices[i] += other.vertices[i];
+    for(size_t i = 0; i < sizeof(primitives) / sizeof(primitives[0]); i++)
+      primitives[i] += other.primitives[i];
+    for(size_t i = 0; i < 256; i++)
+      cones[i] += other.cones[i];
+    for(size_t i = 0; i < 256; i++)
+      bboxExtents[i] += other.bboxExtents[i];
   }
 };
 
@@ -304,6 +411,91 @@ inline vec float32x3_to_octn_precise(vec v, const int n)
   return bestRepresentation;
 }
 
+//////////////////////////////////////////////////////////////////////////
+// float lanes for the SIMD early culling
+
+// How buildMeshletEarlyCulling processes the triangles of a meshlet.
+// The SIMD variants compute bit-identical results 4 (SSE2) or 8 (AVX2)
+// triangles at a time.
+enum EarlyCullingMode
+{
+  EARLY_CULLING_SCALAR,
+  EARLY_CULLING_SSE2,
+  EARLY_CULLING_AVX2,
+#if NVMESHLET_CACHE_AVX2
+  EARLY_CULLING_SIMD = EARLY_CULLING_AVX2,
+#elif NVMESHLET_CACHE_SSE2
+  EARLY_CULLING_SIMD = EARLY_CULLING_SSE2,
+#else
+  EARLY_CULLING_SIMD = EARLY_CULLING_SCALAR,
+#endif
+  EARLY_CULLING_DEFAULT = EARLY_CULLING_SIMD,
+};
+
+#if NVMESHLET_CACHE_SSE2
+struct SimdFloat4
+{
+  typedef __m128        type;
+  static const uint32_t LANES = 4;
+
+  static type load(const float* v) { return _mm_load_ps(v); }
+  static void store(float* v, type a) { _mm_store_ps(v, a); }
+  static type set1(float v) { return _mm_set1_ps(v); }
+  static type add(type a, type b) { return _mm_add_ps(a, b); }
+  static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+  static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+  static type div(type a, type b) { return _mm_div_ps(a, b); }
+  static type sqrt(type a) { return _mm_sqrt_ps(a); }
+  static type min(type a, type b) { return _mm_min_ps(a, b); }
+  static type max(type a, type b) { return _mm_max_ps(a, b); }
+  static type cmpgt(type a, type b) { return _mm_cmpgt_ps(a, b); }
+  static type select(type mask, type a, type b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+  static float reduceMin(type a)
+  {
+    alignas(16) float v[4];
+    _mm_store_ps(v, a);
+    return std::min(std::min(v[0], v[1]), std::min(v[2], v[3]));
+  }
+  static float reduceMax(type a)
+  {
+    alignas(16) float v[4];
+    _mm_store_ps(v, a);
+    return std::max(std::max(v[0], v[1]), std::max(v[2], v[3]));
+  }
+};
+#endif
+
+#if NVMESHLET_CACHE_AVX2
+struct SimdFloat8
+{
+  typedef __m256        type;
+  static const uint32_t LANES = 8;
+
+  static type load(const float* v) { return _mm256_load_ps(v); }
+  static void store(float* v, type a) { _mm256_store_ps(v, a); }
+  static type set1(float v) { return _mm256_set1_ps(v); }
+  static type add(type a, type b) { return _mm256_add_ps(a, b); }
+  static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+  static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+  static type div(type a, type b) { return _mm256_div_ps(a, b); }
+  static type sqrt(type a) { return _mm256_sqrt_ps(a); }
+  static type min(type a, type b) { return _mm256_min_ps(a, b); }
+  static type max(type a, type b) { return _mm256_max_ps(a, b); }
+  static type cmpgt(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+  static type select(type mask, type a, type b) { return _mm256_blendv_ps(b, a, mask); }
+
+  static float reduceMin(type a)
+  {
+    return SimdFloat4::reduceMin(_mm_min_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+  }
+  static float reduceMax(type a)
+  {
+    return SimdFloat4::reduceMax(_mm_max_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+  }
+};
+#endif
+
 //////////////////////////////////////////////////////////////////////////
 
 // quantized vector
@@ -417,6 +609,7 @@ inline uint32_t getBitField(uint32_t arraySize, const uint32_t* bits, uint32_t w
 #if defined(_MSC_VER)
 
 #pragma intrinsic(_BitScanReverse)
+#pragma intrinsic(_BitScanForward)
 
 inline uint32_t findMSB(uint32_t value)
 {
@@ -424,25 +617,114 @@ inline uint32_t findMSB(uint32_t value)
   _BitScanReverse(&idx, value);
   return idx;
 }
+inline uint32_t findLSB(uint32_t value)
+{
+  unsigned long idx = 0;
+  _BitScanForward(&idx, value);
+  return idx;
+}
+inline uint32_t countLeadingZeros(uint32_t value)
+{
+  unsigned long idx = 0;
+  return _BitScanReverse(&idx, value) ? 31 - idx : 32;
+}
+inline uint32_t bitCount(uint32_t value)
+{
+  return __popcnt(value);
+}
 #else
 inline uint32_t findMSB(uint32_t value)
 {
   uint32_t idx = 32 - __builtin_clz(value);
   return idx;
 }
+inline uint32_t findLSB(uint32_t value)
+{
+  uint32_t idx = __builtin_ctz(value);
+  return idx;
+}
+inline uint32_t countLeadingZeros(uint32_t value)
+{
+  return value ? __builtin_clz(value) : 32;
+}
+inline uint32_t bitCount(uint32_t value)
+{
+  return __builtin_popcount(value);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+
+// How PrimitiveCache tests whether a vertex index is already part of
+// the current meshlet. The SIMD variants compare an incoming index against
+// 4 (SSE2) or 8 (AVX2) cached vertices per instruction, but still scale
+// with the vertex count, so the constant-time hash lookup stays the default.
+enum PrimitiveCacheLookup
+{
+  PRIMITIVE_CACHE_LOOKUP_HASH,
+  PRIMITIVE_CACHE_LOOKUP_SSE2,
+  PRIMITIVE_CACHE_LOOKUP_AVX2,
+  PRIMITIVE_CACHE_LOOKUP_DEFAULT = PRIMITIVE_CACHE_LOOKUP_HASH,
+#if NVMESHLET_CACHE_AVX2
+  PRIMITIVE_CACHE_LOOKUP_SIMD = PRIMITIVE_CACHE_LOOKUP_AVX2,
+#elif NVMESHLET_CACHE_SSE2
+  PRIMITIVE_CACHE_LOOKUP_SIMD = PRIMITIVE_CACHE_LOOKUP_SSE2,
+#else
+  PRIMITIVE_CACHE_LOOKUP_SIMD = PRIMITIVE_CACHE_LOOKUP_HASH,
 #endif
+};
 
 //////////////////////////////////////////////////////////////////////////
 
-struct PrimitiveCache
+// smallest power of two >= value
+constexpr uint32_t nextPowerOfTwo(uint32_t value)
+{
+  uint32_t pot = 1;
+  while(pot < value)
+  {
+    pot <<= 1;
+  }
+  return pot;
+}
+
+constexpr uint32_t log2PowerOfTwo(uint32_t pot)
+{
+  uint32_t bits = 0;
+  while(pot > 1)
+  {
+    pot >>= 1;
+    bits++;
+  }
+  return bits;
+}
+
+template <PrimitiveCacheLookup LOOKUP         = PRIMITIVE_CACHE_LOOKUP_DEFAULT,
+          uint32_t             MAX_VERTICES   = MAX_VERTEX_COUNT_LIMIT,
+          uint32_t             MAX_PRIMITIVES = MAX_PRIMITIVE_COUNT_LIMIT>
+struct PrimitiveCacheT
 {
   //  Utility class to generate the meshlets from triangle indices.
   //  It finds the unique vertex set used by a series of primitives.
   //  The cache is exhausted if either of the maximums is hit.
   //  The effective limits used with the cache must be < MAX.
+  //  Storage is sized by MAX_VERTICES and MAX_PRIMITIVES, so caches for
+  //  small meshlets stay compact.
+
+  static_assert(MAX_VERTICES <= MAX_VERTEX_COUNT_LIMIT, "PrimitiveIndexType cannot address MAX_VERTICES");
+  static_assert(MAX_PRIMITIVES <= MAX_PRIMITIVE_COUNT_LIMIT, "MAX_PRIMITIVES exceeds the descriptor encoding");
+
+  // SIMD loads may cover up to 8 entries
+  static const uint32_t VERTEX_CAPACITY = (MAX_VERTICES + 7) & ~7u;
+
+#if !NVMESHLET_CACHE_AVX2
+  static_assert(LOOKUP != PRIMITIVE_CACHE_LOOKUP_AVX2, "AVX2 lookup requires compiling with AVX2 support");
+#endif
+#if !NVMESHLET_CACHE_SSE2
+  static_assert(LOOKUP != PRIMITIVE_CACHE_LOOKUP_SSE2, "SSE2 lookup requires compiling with SSE2 support");
+#endif
 
-  PrimitiveIndexType primitives[MAX_PRIMITIVE_COUNT_LIMIT][3]{};
-  uint32_t           vertices[MAX_VERTEX_COUNT_LIMIT]{};
+  PrimitiveIndexType primitives[MAX_PRIMITIVES][3]{};
+  uint32_t           vertices[VERTEX_CAPACITY]{};
   uint32_t           numPrims{};
   uint32_t           numVertices{};
   uint32_t           numVertexDeltaBits{};
@@ -453,6 +735,20 @@ struct PrimitiveCache
   uint32_t primitiveBits = 1;
   uint32_t maxBlockBits  = ~0;
 
+  //  Lookup from vertex index to its slot within vertices[], only
+  //  maintained for PRIMITIVE_CACHE_LOOKUP_HASH.
+  //  Open-addressing hash with linear probing, kept at most half full.
+  //  Entries are only valid if their stamp matches the current generation,
+  //  which allows reset() to invalidate the table in constant time.
+
+  static const uint32_t VERTEX_HASH_SIZE  = nextPowerOfTwo(MAX_VERTICES * 2);
+  static const uint32_t VERTEX_HASH_SHIFT = 32 - log2PowerOfTwo(VERTEX_HASH_SIZE);
+
+  uint32_t           hashKeys[VERTEX_HASH_SIZE]{};
+  uint32_t           hashStamps[VERTEX_HASH_SIZE]{};
+  PrimitiveIndexType hashSlots[VERTEX_HASH_SIZE]{};
+  uint32_t           hashGeneration = 1;
+
   [[nodiscard]] bool empty() const { return numVertices == 0; }
 
   void reset()
@@ -461,8 +757,118 @@ struct PrimitiveCache
     numVertices        = 0;
     numVertexDeltaBits = 0;
     numVertexAllBits   = 0;
-    // reset
-    memset(vertices, static_cast<int>(0xFFFFFFFF), sizeof(vertices));
+
+    if(LOOKUP == PRIMITIVE_CACHE_LOOKUP_HASH)
+    {
+      hashGeneration++;
+      if(hashGeneration == 0)
+      {
+        // stamps wrapped around, must really clear once
+        memset(hashStamps, 0, sizeof(hashStamps));
+        hashGeneration = 1;
+      }
+    }
+  }
+
+  static uint32_t vertexHash(uint32_t idx) { return (idx * 0x9E3779B1u) >> VERTEX_HASH_SHIFT; }
+
+  // returns slot within vertices[] or ~0 if not found
+  [[nodiscard]] uint32_t findVertex(uint32_t idx) const
+  {
+#if NVMESHLET_CACHE_SSE2
+    if constexpr(LOOKUP != PRIMITIVE_CACHE_LOOKUP_HASH)
+    {
+      // the last load may cover stale entries past numVertices, they
+      // stay within vertices[] and lie behind all valid lanes
+      for(uint32_t v = 0; v < numVertices; v += SIMD_LANES)
+      {
+        uint32_t mask = compareVertices(v, idx);
+        if(mask)
+        {
+          uint32_t slot = v + findLSB(mask);
+          return slot < numVertices ? slot : ~0u;
+        }
+      }
+      return ~0u;
+    }
+#endif
+    for(uint32_t h = vertexHash(idx);; h = (h + 1) & (VERTEX_HASH_SIZE - 1))
+    {
+      if(hashStamps[h] != hashGeneration)
+      {
+        return ~0u;
+      }
+      if(hashKeys[h] == idx)
+      {
+        return hashSlots[h];
+      }
+    }
+  }
+
+  void addVertex(uint32_t idx, uint32_t slot)
+  {
+    if(LOOKUP != PRIMITIVE_CACHE_LOOKUP_HASH)
+    {
+      return;
+    }
+
+    uint32_t h = vertexHash(idx);
+    while(hashStamps[h] == hashGeneration)
+    {
+      h = (h + 1) & (VERTEX_HASH_SIZE - 1);
+    }
+    hashKeys[h]   = idx;
+    hashSlots[h]  = PrimitiveIndexType(slot);
+    hashStamps[h] = hashGeneration;
+  }
+
+#if NVMESHLET_CACHE_SSE2
+  static const uint32_t SIMD_LANES = LOOKUP == PRIMITIVE_CACHE_LOOKUP_AVX2 ? 8 : 4;
+
+  // bit per lane of vertices[v, v + SIMD_LANES) that is still valid
+  [[nodiscard]] uint32_t laneMask(uint32_t v) const
+  {
+    uint32_t valid = numVertices - v;
+    return valid >= SIMD_LANES ? (1u << SIMD_LANES) - 1 : (1u << valid) - 1;
+  }
+
+  // bit per lane of vertices[v, v + SIMD_LANES) that equals idx
+  [[nodiscard]] uint32_t compareVertices(uint32_t v, uint32_t idx) const
+  {
+#if NVMESHLET_CACHE_AVX2
+    if constexpr(LOOKUP == PRIMITIVE_CACHE_LOOKUP_AVX2)
+    {
+      __m256i cached = _mm256_loadu_si256((const __m256i*)&vertices[v]);
+      __m256i equal  = _mm256_cmpeq_epi32(cached, _mm256_set1_epi32(int(idx)));
+      return uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+    }
+#endif
+    __m128i cached = _mm_loadu_si128((const __m128i*)&vertices[v]);
+    __m128i equal  = _mm_cmpeq_epi32(cached, _mm_set1_epi32(int(idx)));
+    return uint32_t(_mm_movemask_ps(_mm_castsi128_ps(equal)));
+  }
+#endif
+
+  [[nodiscard]] uint32_t countFound(const uint32_t indices[3]) const
+  {
+#if NVMESHLET_CACHE_SSE2
+    if constexpr(LOOKUP != PRIMITIVE_CACHE_LOOKUP_HASH)
+    {
+      uint32_t foundA = 0;
+      uint32_t foundB = 0;
+      uint32_t foundC = 0;
+      for(uint32_t v = 0; v < numVertices; v += SIMD_LANES)
+      {
+        uint32_t valid = laneMask(v);
+        foundA |= compareVertices(v, indices[0]) & valid;
+        foundB |= compareVertices(v, indices[1]) & valid;
+        foundC |= compareVertices(v, indices[2]) & valid;
+      }
+      return (foundA ? 1 : 0) + (foundB ? 1 : 0) + (foundC ? 1 : 0);
+    }
+#endif
+    return (findVertex(indices[0]) != ~0u ? 1 : 0) + (findVertex(indices[1]) != ~0u ? 1 : 0)
+           + (findVertex(indices[2]) != ~0u ? 1 : 0);
   }
 
   [[nodiscard]] bool fitsBlock() const
@@ -485,17 +891,7 @@ struct PrimitiveCache
       return false;
     }
 
-    uint32_t found = 0;
-    for(uint32_t v = 0; v < numVertices; v++)
-    {
-      for(unsigned int idx : indices)
-      {
-        if(vertices[v] == idx)
-        {
-          found++;
-        }
-      }
-    }
+    uint32_t found = countFound(indices);
     // out of bounds
     return (numVertices + 3 - found) > maxVertexSize || (numPrims + 1) > maxPrimitiveSize;
   }
@@ -509,17 +905,7 @@ struct PrimitiveCache
       return false;
     }
 
-    uint32_t found = 0;
-    for(uint32_t v = 0; v < numVertices; v++)
-    {
-      for(unsigned int idx : indices)
-      {
-        if(vertices[v] == idx)
-        {
-          found++;
-        }
-      }
-    }
+    uint32_t found = countFound(indices);
     // ensure one bit is set in deltas for findMSB returning 0
     uint32_t firstVertex = numVertices ? vertices[0] : indices[0];
     uint32_t cmpBits     = std::max(findMSB((firstVertex ^ indices[0]) | 1),
@@ -556,21 +942,17 @@ struct PrimitiveCache
 
     for(int i = 0; i < 3; i++)
     {
-      uint32_t idx   = indices[i];
-      bool     found = false;
-      for(uint32_t v = 0; v < numVertices; v++)
+      uint32_t idx  = indices[i];
+      uint32_t slot = findVertex(idx);
+      if(slot != ~0u)
       {
-        if(idx == vertices[v])
-        {
-          tri[i] = v;
-          found  = true;
-          break;
-        }
+        tri[i] = slot;
       }
-      if(!found)
+      else
       {
         vertices[numVertices] = idx;
         tri[i]                = numVertices;
+        addVertex(idx, numVertices);
 
         if(numVertices)
         {
@@ -591,6 +973,8 @@ struct PrimitiveCache
   }
 };
 
+typedef PrimitiveCacheT<> PrimitiveCache;
+
 }  // namespace NVMeshlet
 
 #endif
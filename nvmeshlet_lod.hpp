@@ -0,0 +1,661 @@
+/*
+ * Copyright (c) 2017-2022, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * SPDX-FileCopyrightText: Copyright (c) 2017-2022 NVIDIA CORPORATION
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef _NV_MESHLET_LOD_H__
+#define _NV_MESHLET_LOD_H__
+
+#include "nvmeshlet_packbasic.hpp"
+
+#include <cfloat>
+#include <cmath>
+#include <unordered_map>
+
+namespace NVMeshlet {
+
+//////////////////////////////////////////////////////////////////////////
+// Meshlet lod hierarchy
+//
+// Level 0 are the meshlets of the input triangles. Every further level is
+// built by grouping neighbouring meshlets of the previous level, simplifying
+// each group's triangles with the group border locked and building new
+// meshlets from the result. Simplification only collapses vertices onto
+// existing ones, all levels reference the original vertices.
+//
+// Each meshlet stores the bounds and error of the group that created it and
+// of the group that replaces it (MeshletLod). All meshlets created by a group
+// share the former, all meshlets replaced by a group share the latter, so
+// choosing per meshlet
+//
+//   drawn = isLodErrorAcceptable(own) && !isLodErrorAcceptable(parent)
+//
+// always selects whole groups and the locked borders keep the cut crack free.
+// Parent bounds enclose the child bounds and parent errors are not smaller
+// than child errors, which makes the decision monotonic with distance.
+
+struct LodConfig
+{
+  // meshlets of the previous level per group
+  uint32_t groupSize = 4;
+  // groups whose simplification keeps more triangles than this ratio
+  // are not replaced, their meshlets become roots
+  float maxTriangleRatio = 0.85f;
+  uint32_t maxLevels      = 16;
+};
+
+struct LodStats
+{
+  uint32_t numHierarchies = 0;
+  uint32_t numLevels      = 0;
+  uint32_t numMeshlets    = 0;
+  uint32_t numRoots       = 0;
+};
+
+// errorScale converts object space errors to the pixel threshold at unit distance:
+//   errorScale = viewportHeight / (2 * tan(fovy / 2)) / pixelThreshold
+// Same as isMeshletLodSelected in the task shaders.
+inline bool isLodErrorAcceptable(const float bounds[4], float error, const float viewPos[3], float errorScale)
+{
+  float delta[3] = {bounds[0] - viewPos[0], bounds[1] - viewPos[1], bounds[2] - viewPos[2]};
+  float distance = sqrtf(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]) - bounds[3];
+  return error * errorScale <= std::max(distance, 0.0f);
+}
+
+inline bool isMeshletLodSelected(const MeshletLod& lod, const float viewPos[3], float errorScale)
+{
+  return isLodErrorAcceptable(lod.bounds, lod.error, viewPos, errorScale)
+         && !isLodErrorAcceptable(lod.parentBounds, lod.parentError, viewPos, errorScale);
+}
+
+// Appends the meshlets within [meshletBegin, meshletEnd) that form the cut
+// for the object space viewPos. Works on stored topology (see
+// PackBasicBuilder::appendMeshletLods), invalid padding descriptors are skipped.
+inline uint32_t selectMeshletLodCut(const MeshletPackBasicDesc* descs,
+                                    const PackBasicType*        packs,
+                                    uint32_t                    meshletBegin,
+                                    uint32_t                    meshletEnd,
+                                    bool                        hasPositions,
+                                    const float                 viewPos[3],
+                                    float                       errorScale,
+                                    std::vector<uint32_t>&      selected)
+{
+  uint32_t numTriangles = 0;
+  for(uint32_t m = meshletBegin; m < meshletEnd; m++)
+  {
+    const MeshletPackBasicDesc& meshlet = descs[m];
+    if(!meshlet.fieldX)
+    {
+      continue;
+    }
+
+    const auto* pack = (const MeshletPackBasic*)&packs[meshlet.getPackOffset()];
+
+    MeshletLod lod;
+    pack->getLod(PackBasicBuilder::getExtraStart(meshlet, pack, hasPositions), lod);
+    if(isMeshletLodSelected(lod, viewPos, errorScale))
+    {
+      selected.push_back(m);
+      numTriangles += meshlet.getNumPrims();
+    }
+  }
+  return numTriangles;
+}
+
+namespace lod {
+
+inline void getSphere(const float* positions, uint32_t positionStride, const std::vector<uint32_t>& indices, float sphere[4])
+{
+  float bboxMin[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+  float bboxMax[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+  for(uint32_t idx : indices)
+  {
+    const float* pos = (const float*)((const uint8_t*)positions + size_t(idx) * positionStride);
+    for(uint32_t c = 0; c < 3; c++)
+    {
+      bboxMin[c] = std::min(bboxMin[c], pos[c]);
+      bboxMax[c] = std::max(bboxMax[c], pos[c]);
+    }
+  }
+
+  float radius = 0;
+  for(uint32_t c = 0; c < 3; c++)
+  {
+    sphere[c] = (bboxMin[c] + bboxMax[c]) * 0.5f;
+  }
+  for(uint32_t idx : indices)
+  {
+    const float* pos = (const float*)((const uint8_t*)positions + size_t(idx) * positionStride);
+    float delta[3] = {pos[0] - sphere[0], pos[1] - sphere[1], pos[2] - sphere[2]};
+    radius         = std::max(radius, delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+  }
+  sphere[3] = sqrtf(radius);
+}
+
+// grows sphere to enclose other
+inline void mergeSphere(float sphere[4], const float other[4])
+{
+  float delta[3] = {other[0] - sphere[0], other[1] - sphere[1], other[2] - sphere[2]};
+  float distance = sqrtf(delta[0] * delta[0] + delta[1] * delta[1] + delta[2] * delta[2]);
+
+  if(distance + other[3] <= sphere[3])
+  {
+    return;
+  }
+  if(distance + sphere[3] <= other[3])
+  {
+    memcpy(sphere, other, sizeof(float) * 4);
+    return;
+  }
+
+  float radius = (distance + sphere[3] + other[3]) * 0.5f;
+  float t      = (radius - sphere[3]) / distance;
+  for(uint32_t c = 0; c < 3; c++)
+  {
+    sphere[c] += delta[c] * t;
+  }
+  // guard against rounding
+  sphere[3] = radius * 1.0001f;
+}
+
+inline uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+  return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+
+// Reduces the triangles towards targetTriangles by collapsing vertices onto
+// a neighbour (half-edge collapse) in order of their quadric error. Vertices
+// on edges used by a single triangle, the group border, stay in place.
+// Returns the largest collapse error as object space distance.
+inline float simplifyTriangles(std::vector<uint32_t>& indices, uint32_t targetTriangles, const float* positions, uint32_t positionStride)
+{
+  // local vertices
+  std::unordered_map<uint32_t, uint32_t> localMap;
+  std::vector<uint32_t>                  globals;
+  std::vector<uint32_t>                  tris(indices.size());
+  for(size_t i = 0; i < indices.size(); i++)
+  {
+    auto it = localMap.find(indices[i]);
+    if(it == localMap.end())
+    {
+      it = localMap.insert({indices[i], uint32_t(globals.size())}).first;
+      globals.push_back(indices[i]);
+    }
+    tris[i] = it->second;
+  }
+
+  uint32_t            numVertices = uint32_t(globals.size());
+  std::vector<double> pos(numVertices * 3);
+  for(uint32_t v = 0; v < numVertices; v++)
+  {
+    const float* vpos = (const float*)((const uint8_t*)positions + size_t(globals[v]) * positionStride);
+    pos[v * 3 + 0]    = vpos[0];
+    pos[v * 3 + 1]    = vpos[1];
+    pos[v * 3 + 2]    = vpos[2];
+  }
+
+  // border and non-manifold edges lock their vertices
+  std::vector<uint8_t> locked(numVertices, 0);
+  {
+    std::unordered_map<uint64_t, uint32_t> edgeCount;
+    for(size_t t = 0; t < tris.size(); t += 3)
+    {
+      for(uint32_t e = 0; e < 3; e++)
+      {
+        edgeCount[edgeKey(tris[t + e], tris[t + (e + 1) % 3])]++;
+      }
+    }
+    for(const auto& it : edgeCount)
+    {
+      if(it.second != 2)
+      {
+        locked[uint32_t(it.first >> 32)] = 1;
+        locked[uint32_t(it.first)]       = 1;
+      }
+    }
+  }
+
+  auto getNormal = [&](uint32_t a, uint32_t b, uint32_t c, double n[3]) {
+    double e0[3] = {pos[b * 3 + 0] - pos[a * 3 + 0], pos[b * 3 + 1] - pos[a * 3 + 1], pos[b * 3 + 2] - pos[a * 3 + 2]};
+    double e1[3] = {pos[c * 3 + 0] - pos[a * 3 + 0], pos[c * 3 + 1] - pos[a * 3 + 1], pos[c * 3 + 2] - pos[a * 3 + 2]};
+    n[0]         = e0[1] * e1[2] - e0[2] * e1[1];
+    n[1]         = e0[2] * e1[0] - e0[0] * e1[2];
+    n[2]         = e0[0] * e1[1] - e0[1] * e1[0];
+  };
+
+  // quadrics of the normalized triangle planes
+  // a2, ab, ac, ad, b2, bc, bd, c2, cd, d2
+  std::vector<double> quadrics(numVertices * 10, 0.0);
+  for(size_t t = 0; t < tris.size(); t += 3)
+  {
+    double n[3];
+    getNormal(tris[t + 0], tris[t + 1], tris[t + 2], n);
+    double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if(length == 0.0)
+    {
+      continue;
+    }
+    double a = n[0] / length;
+    double b = n[1] / length;
+    double c = n[2] / length;
+    double d = -(a * pos[tris[t] * 3 + 0] + b * pos[tris[t] * 3 + 1] + c * pos[tris[t] * 3 + 2]);
+
+    const double plane[10] = {a * a, a * b, a * c, a * d, b * b, b * c, b * d, c * c, c * d, d * d};
+    for(uint32_t k = 0; k < 3; k++)
+    {
+      for(uint32_t q = 0; q < 10; q++)
+      {
+        quadrics[tris[t + k] * 10 + q] += plane[q];
+      }
+    }
+  }
+
+  auto evalQuadric = [&](uint32_t v, const double* p) {
+    const double* q = &quadrics[v * 10];
+    double        x = p[0], y = p[1], z = p[2];
+    return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x + q[4] * y * y + 2 * q[5] * y * z
+           + 2 * q[6] * y + q[7] * z * z + 2 * q[8] * z + q[9];
+  };
+
+  struct Collapse
+  {
+    double   cost;
+    uint32_t from;
+    uint32_t to;
+  };
+
+  std::vector<uint32_t> remap(numVertices);
+  std::vector<uint32_t> touched(numVertices);
+  std::vector<uint32_t> adjacencyOffsets(numVertices + 1);
+  std::vector<uint32_t> adjacency;
+  std::vector<Collapse> collapses;
+  double                maxCost      = 0;
+  uint32_t              numTriangles = uint32_t(tris.size() / 3);
+
+  while(numTriangles > targetTriangles)
+  {
+    // vertex to triangle adjacency
+    std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+    for(uint32_t v : tris)
+    {
+      adjacencyOffsets[v + 1]++;
+    }
+    for(uint32_t v = 0; v < numVertices; v++)
+    {
+      adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    adjacency.resize(tris.size());
+    {
+      std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for(size_t i = 0; i < tris.size(); i++)
+      {
+        adjacency[fill[tris[i]]++] = uint32_t(i / 3);
+      }
+    }
+
+    collapses.clear();
+    for(size_t t = 0; t < tris.size(); t += 3)
+    {
+      for(uint32_t e = 0; e < 3; e++)
+      {
+        uint32_t a = tris[t + e];
+        uint32_t b = tris[t + (e + 1) % 3];
+        if(!locked[a])
+        {
+          collapses.push_back({evalQuadric(a, &pos[b * 3]) + evalQuadric(b, &pos[b * 3]), a, b});
+        }
+        if(!locked[b])
+        {
+          collapses.push_back({evalQuadric(b, &pos[a * 3]) + evalQuadric(a, &pos[a * 3]), b, a});
+        }
+      }
+    }
+    std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+      return a.cost < b.cost || (a.cost == b.cost && (a.from < b.from || (a.from == b.from && a.to < b.to)));
+    });
+
+    for(uint32_t v = 0; v < numVertices; v++)
+    {
+      remap[v] = v;
+    }
+    std::fill(touched.begin(), touched.end(), 0);
+
+    uint32_t numCollapsed = 0;
+    for(const Collapse& collapse : collapses)
+    {
+      if(numTriangles <= targetTriangles)
+      {
+        break;
+      }
+
+      uint32_t from = collapse.from;
+      uint32_t to   = collapse.to;
+      if(touched[from] || touched[to])
+      {
+        continue;
+      }
+
+      // reject collapses that flip triangles around "from" or whose
+      // triangles were changed by this pass already
+      bool     flips   = false;
+      uint32_t removed = 0;
+      for(uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1] && !flips; a++)
+      {
+        const uint32_t* tri = &tris[adjacency[a] * 3];
+        if(touched[tri[0]] || touched[tri[1]] || touched[tri[2]])
+        {
+          flips = true;
+          break;
+        }
+        if(tri[0] == to || tri[1] == to || tri[2] == to)
+        {
+          removed++;
+          continue;
+        }
+        uint32_t moved[3] = {tri[0] == from ? to : tri[0], tri[1] == from ? to : tri[1], tri[2] == from ? to : tri[2]};
+
+        double before[3];
+        double after[3];
+        getNormal(tri[0], tri[1], tri[2], before);
+        getNormal(moved[0], moved[1], moved[2], after);
+        double dotBefore = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+        double lenBefore = before[0] * before[0] + before[1] * before[1] + before[2] * before[2];
+        double lenAfter  = after[0] * after[0] + after[1] * after[1] + after[2] * after[2];
+        flips            = dotBefore <= 0.25 * sqrt(lenBefore * lenAfter);
+      }
+      if(flips || !removed)
+      {
+        continue;
+      }
+
+      // vertices of the affected triangles are left alone for this pass
+      for(uint32_t a = adjacencyOffsets[from]; a < adjacencyOffsets[from + 1]; a++)
+      {
+        const uint32_t* tri = &tris[adjacency[a] * 3];
+        touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+      }
+      for(uint32_t a = adjacencyOffsets[to]; a < adjacencyOffsets[to + 1]; a++)
+      {
+        const uint32_t* tri = &tris[adjacency[a] * 3];
+        touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+      }
+
+      remap[from] = to;
+      for(uint32_t q = 0; q < 10; q++)
+      {
+        quadrics[to * 10 + q] += quadrics[from * 10 + q];
+      }
+      maxCost = std::max(maxCost, collapse.cost);
+      numTriangles -= removed;
+      numCollapsed++;
+    }
+
+    if(!numCollapsed)
+    {
+      break;
+    }
+
+    size_t numIndices = 0;
+    for(size_t t = 0; t < tris.size(); t += 3)
+    {
+      uint32_t a = remap[tris[t + 0]];
+      uint32_t b = remap[tris[t + 1]];
+      uint32_t c = remap[tris[t + 2]];
+      if(a != b && a != c && b != c)
+      {
+        tris[numIndices++] = a;
+        tris[numIndices++] = b;
+        tris[numIndices++] = c;
+      }
+    }
+    tris.resize(numIndices);
+    numTriangles = uint32_t(numIndices / 3);
+  }
+
+  indices.resize(tris.size());
+  for(size_t i = 0; i < tris.size(); i++)
+  {
+    indices[i] = globals[tris[i]];
+  }
+
+  return float(sqrt(std::max(maxCost, 0.0)));
+}
+
+// vertex indices of a meshlet's triangles
+inline void getMeshletTriangles(const PackBasicMeshletGeometry& geometry, size_t meshletIndex, std::vector<uint32_t>& indices)
+{
+  const MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[meshletIndex];
+  const auto*                 pack = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+  indices.clear();
+  for(uint32_t p = 0; p < meshlet.getNumPrims(); p++)
+  {
+    uint8_t local[3];
+    pack->getPrimIndices(meshlet, p, local);
+    for(uint32_t k = 0; k < 3; k++)
+    {
+      indices.push_back(pack->getVertexIndex(local[k], meshlet.getNumVertexPack()));
+    }
+  }
+}
+
+}  // namespace lod
+
+//////////////////////////////////////////////////////////////////////////
+// Builds the lod hierarchy of one triangle mesh (a part) into "geometry",
+// which must be empty, and provides one MeshletLod per meshlet in "lods".
+// Every level uses buildMeshletsSpatial, its compact meshlets keep the group
+// borders short, which otherwise limit simplification. Run the
+// remaining build functions on the result as usual, followed by
+// PackBasicBuilder::appendMeshletLods.
+
+template <class Builder>
+void buildMeshletLodHierarchy(const Builder&                  builder,
+                              PackBasicMeshletGeometry&       geometry,
+                              std::vector<MeshletLod>&        lods,
+                              uint32_t                        numIndices,
+                              const uint32_t* NV_RESTRICT     indices,
+                              const float* NV_RESTRICT        positions,
+                              uint32_t                        positionStride,
+                              const LodConfig&                config,
+                              LodStats*                       stats = nullptr)
+{
+  assert(geometry.meshletDescriptors.empty());
+
+  std::vector<uint32_t> clusterIndices;
+
+  builder.template buildMeshletsSpatial<uint32_t>(geometry, numIndices, indices, positions, positionStride);
+
+  // level 0, bounds of their own vertices and no error
+  lods.resize(geometry.meshletDescriptors.size());
+  for(size_t m = 0; m < lods.size(); m++)
+  {
+    lod::getMeshletTriangles(geometry, m, clusterIndices);
+    lod::getSphere(positions, positionStride, clusterIndices, lods[m].bounds);
+    lods[m].error       = 0;
+    lods[m].parentError = FLT_MAX;
+    memcpy(lods[m].parentBounds, lods[m].bounds, sizeof(lods[m].bounds));
+  }
+
+  uint32_t levelBegin = 0;
+  uint32_t levelEnd   = uint32_t(lods.size());
+  uint32_t numLevels  = 1;
+
+  std::vector<std::pair<uint32_t, uint32_t>> vertexClusters;
+  std::vector<uint32_t>                      clusterGroup;
+  std::vector<uint32_t>                      group;
+  std::vector<std::vector<uint32_t>>         groups;
+  std::vector<uint32_t>                      groupIndices;
+  std::unordered_map<uint32_t, uint32_t>     sharedCounts;
+
+  while(levelEnd - levelBegin > 1 && numLevels < config.maxLevels)
+  {
+    uint32_t numClusters = levelEnd - levelBegin;
+
+    // (vertex, cluster) pairs to find neighbouring clusters
+    vertexClusters.clear();
+    for(uint32_t c = 0; c < numClusters; c++)
+    {
+      lod::getMeshletTriangles(geometry, levelBegin + c, clusterIndices);
+      for(uint32_t idx : clusterIndices)
+      {
+        vertexClusters.push_back({idx, c});
+      }
+    }
+    std::sort(vertexClusters.begin(), vertexClusters.end());
+    vertexClusters.erase(std::unique(vertexClusters.begin(), vertexClusters.end()), vertexClusters.end());
+
+    clusterGroup.assign(numClusters, ~0u);
+
+    // clusters sharing the most vertices with the given ones, per group or cluster
+    auto countShared = [&](const std::vector<uint32_t>& clusters, bool grouped) {
+      sharedCounts.clear();
+      for(uint32_t c : clusters)
+      {
+        lod::getMeshletTriangles(geometry, levelBegin + c, clusterIndices);
+        for(uint32_t idx : clusterIndices)
+        {
+          auto it = std::lower_bound(vertexClusters.begin(), vertexClusters.end(), std::make_pair(idx, 0u));
+          for(; it != vertexClusters.end() && it->first == idx; ++it)
+          {
+            if((clusterGroup[it->second] != ~0u) == grouped && clusterGroup[it->second] != clusterGroup[c])
+            {
+              sharedCounts[grouped ? clusterGroup[it->second] : it->second]++;
+            }
+          }
+        }
+      }
+
+      uint32_t best      = ~0u;
+      uint32_t bestCount = 0;
+      for(const auto& it : sharedCounts)
+      {
+        if(it.second > bestCount || (it.second == bestCount && it.first < best))
+        {
+          best      = it.first;
+          bestCount = it.second;
+        }
+      }
+      return best;
+    };
+
+    // grow each group greedily by the cluster sharing the most vertices,
+    // leftover single clusters join the neighbouring group instead
+    groups.clear();
+    for(uint32_t seed = 0; seed < numClusters; seed++)
+    {
+      if(clusterGroup[seed] != ~0u)
+      {
+        continue;
+      }
+
+      group.clear();
+      group.push_back(seed);
+      clusterGroup[seed] = uint32_t(groups.size());
+      while(group.size() < config.groupSize)
+      {
+        uint32_t best = countShared(group, false);
+        if(best == ~0u)
+        {
+          break;
+        }
+        group.push_back(best);
+        clusterGroup[best] = uint32_t(groups.size());
+      }
+
+      uint32_t neighbour = group.size() == 1 ? countShared(group, true) : ~0u;
+      if(neighbour != ~0u)
+      {
+        groups[neighbour].push_back(seed);
+        clusterGroup[seed] = neighbour;
+      }
+      else
+      {
+        groups.push_back(group);
+      }
+    }
+
+    uint32_t levelNext = uint32_t(geometry.meshletDescriptors.size());
+    for(const std::vector<uint32_t>& group : groups)
+    {
+      // merged triangles, bounds and error
+      groupIndices.clear();
+      float groupBounds[4];
+      float groupError = 0;
+      memcpy(groupBounds, lods[levelBegin + group[0]].bounds, sizeof(groupBounds));
+      for(uint32_t c : group)
+      {
+        lod::getMeshletTriangles(geometry, levelBegin + c, clusterIndices);
+        groupIndices.insert(groupIndices.end(), clusterIndices.begin(), clusterIndices.end());
+        lod::mergeSphere(groupBounds, lods[levelBegin + c].bounds);
+        groupError = std::max(groupError, lods[levelBegin + c].error);
+      }
+
+      uint32_t groupTriangles = uint32_t(groupIndices.size() / 3);
+      float simplifyError = lod::simplifyTriangles(groupIndices, groupTriangles / 2, positions, positionStride);
+      if(groupIndices.empty() || float(groupIndices.size() / 3) > float(groupTriangles) * config.maxTriangleRatio)
+      {
+        // stays a root
+        continue;
+      }
+      groupError = std::max(groupError, simplifyError);
+
+      for(uint32_t c : group)
+      {
+        MeshletLod& child = lods[levelBegin + c];
+        memcpy(child.parentBounds, groupBounds, sizeof(groupBounds));
+        child.parentError = groupError;
+      }
+
+      size_t meshletBegin = geometry.meshletDescriptors.size();
+      builder.template buildMeshletsSpatial<uint32_t>(geometry, uint32_t(groupIndices.size()), groupIndices.data(), positions, positionStride);
+      for(size_t m = meshletBegin; m < geometry.meshletDescriptors.size(); m++)
+      {
+        MeshletLod parent;
+        memcpy(parent.bounds, groupBounds, sizeof(groupBounds));
+        memcpy(parent.parentBounds, groupBounds, sizeof(groupBounds));
+        parent.error       = groupError;
+        parent.parentError = FLT_MAX;
+        lods.push_back(parent);
+      }
+    }
+
+    levelBegin = levelNext;
+    levelEnd   = uint32_t(geometry.meshletDescriptors.size());
+    if(levelEnd == levelBegin)
+    {
+      break;
+    }
+    numLevels++;
+  }
+
+  if(stats)
+  {
+    stats->numHierarchies++;
+    stats->numLevels += numLevels;
+    stats->numMeshlets += uint32_t(lods.size());
+    for(const MeshletLod& lod : lods)
+    {
+      stats->numRoots += lod.parentError == FLT_MAX ? 1 : 0;
+    }
+  }
+}
+
+}  // namespace NVMeshlet
+
+#endif
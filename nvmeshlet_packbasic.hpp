@@ -23,11 +23,20 @@
 
 #include "nvmeshlet_builder.hpp"
 
+#include <tuple>
+
 namespace NVMeshlet {
 
 static const uint32_t PACKBASIC_ALIGN = 16;
 // how many indices are fetched per thread, 8 or 4
 static const uint32_t PACKBASIC_PRIMITIVE_INDICES_PER_FETCH = 8;
+// vertexPack flag for delta encoded vertex indices, lower bits store the delta width
+static const uint32_t PACKBASIC_VERTEX_DELTA = 0x80;
+// vertexPack flag for primitives stored as triangle strips, see MeshletPackBasic
+static const uint32_t PACKBASIC_PRIM_STRIPS = 0x40;
+// strips restart at multiples of this, so that a primitive's strip starts
+// within the same word of restart bits
+static const uint32_t PACKBASIC_STRIP_RESTART_INTERVAL = 32;
 
 typedef uint32_t PackBasicType;
 
@@ -56,6 +65,8 @@ struct MeshletPackBasicDesc
   //  coneOctY    | 8    | octant coordinate for cone normal, SNORM8
   //  coneAngle   | 8    | -sin(cone.angle),  SNORM8
   //  vertexPack  | 8    | vertex indices per 32 bits (1 or 2)
+  //              |      | or PACKBASIC_VERTEX_DELTA | delta bits (1..31)
+  //              |      | | PACKBASIC_PRIM_STRIPS if primitives are strips
   //  ------------|:----:|----------------------------------------------
   //   Field.W    |      |
   //  ------------|:----:|----------------------------------------------
@@ -112,30 +123,49 @@ struct MeshletPackBasicDesc
     fieldY |= pack(num - 1, 8, 24);
   }
 
-  [[nodiscard]] uint32_t getNumVertexPack() const { return unpack(fieldZ, 8, 24); }
+  [[nodiscard]] uint32_t getNumVertexPack() const { return unpack(fieldZ, 8, 24) & ~PACKBASIC_PRIM_STRIPS; }
   void                   setNumVertexPack(uint32_t num) { fieldZ |= pack(num, 8, 24); }
 
+  [[nodiscard]] bool hasPrimStrips() const { return (unpack(fieldZ, 8, 24) & PACKBASIC_PRIM_STRIPS) != 0; }
+  void               setPrimStrips() { fieldZ |= pack(PACKBASIC_PRIM_STRIPS, 8, 24); }
+
   [[nodiscard]] uint32_t getPackOffset() const { return fieldW; }
   void                   setPackOffset(uint32_t index) { fieldW = index; }
 
   [[nodiscard]] uint32_t getVertexStart() const { return 0; }
   [[nodiscard]] uint32_t getVertexSize() const
   {
-    uint32_t vertexDiv   = getNumVertexPack();
+    uint32_t vertexPack = getNumVertexPack();
+    if(vertexPack & PACKBASIC_VERTEX_DELTA)
+    {
+      // base index + bit-packed deltas
+      uint32_t deltaBits = vertexPack & ~PACKBASIC_VERTEX_DELTA;
+      return 1 + (getNumVertices() * deltaBits + 31) / 32;
+    }
+
+    uint32_t vertexDiv   = vertexPack;
     uint32_t vertexElems = ((getNumVertices() + vertexDiv - 1) / vertexDiv);
 
     return vertexElems;
   }
 
   [[nodiscard]] uint32_t getPrimStart() const { return (getVertexStart() + getVertexSize() + 1) & (~1u); }
+  // triangle lists only, the size of strips depends on the number of
+  // restarts, see MeshletPackBasic::getPrimSize
   [[nodiscard]] uint32_t getPrimSize() const
   {
+    assert(!hasPrimStrips());
     uint32_t primDiv   = 4;
     uint32_t primElems = ((getNumPrims() * 3 + PACKBASIC_PRIMITIVE_INDICES_PER_FETCH - 1) / primDiv);
 
     return primElems;
   }
 
+  [[nodiscard]] uint32_t getPrimStripRestartWords() const
+  {
+    return (getNumPrims() + PACKBASIC_STRIP_RESTART_INTERVAL - 1) / PACKBASIC_STRIP_RESTART_INTERVAL;
+  }
+
   // positions are relative to object's bbox treated as UNORM
   void setBBox(uint8_t const bboxMin[3], uint8_t const bboxMax[3])
   {
@@ -146,12 +176,12 @@ struct MeshletPackBasicDesc
   void getBBox(uint8_t bboxMin[3], uint8_t bboxMax[3]) const
   {
     bboxMin[0] = unpack(fieldX, 8, 0);
-    bboxMin[0] = unpack(fieldX, 8, 8);
-    bboxMin[0] = unpack(fieldX, 8, 16);
+    bboxMin[1] = unpack(fieldX, 8, 8);
+    bboxMin[2] = unpack(fieldX, 8, 16);
 
     bboxMax[0] = unpack(fieldY, 8, 0);
-    bboxMax[0] = unpack(fieldY, 8, 8);
-    bboxMax[0] = unpack(fieldY, 8, 16);
+    bboxMax[1] = unpack(fieldY, 8, 8);
+    bboxMax[2] = unpack(fieldY, 8, 16);
   }
 
   // uses octant encoding for cone Normal
@@ -180,6 +210,19 @@ struct MeshletPackBasicDesc
   }
 };
 
+// Bounds (center, radius) and object space error of the group of meshlets
+// that created a meshlet and of the group that replaces it in the next
+// coarser level, see nvmeshlet_lod.hpp. Roots have a parentError of FLT_MAX.
+struct MeshletLod
+{
+  float bounds[4];
+  float parentBounds[4];
+  float error;
+  float parentError;
+};
+
+static const uint32_t PACKBASIC_LOD_SIZE = sizeof(MeshletLod) / sizeof(PackBasicType);
+
 struct MeshletPackBasic
 {
 
@@ -188,10 +231,36 @@ struct MeshletPackBasic
   // aligned to PACKBASIC_ALIGN bytes
   // - first sequence is either 16 or 32 bit indices per vertex
   //   (vertexPack is 2 or 1) respectively
+  //   or a 32 bit base index followed by bit-packed deltas
+  //   (vertexPack is PACKBASIC_VERTEX_DELTA | delta bits)
   // - second sequence aligned to 8 bytes, primitive many 8 bit values
   //
   //
   // { u32[numVertices/vertexPack ...], padding..., u8[(numPrimitives) * 3 ...] }
+  // { u32 base, bits[numVertices * deltaBits ...], padding..., u8[(numPrimitives) * 3 ...] }
+  //
+  // - or, with PACKBASIC_PRIM_STRIPS, the primitives as triangle strips. One
+  //   restart bit per primitive marks the first one of each strip, the strips'
+  //   indices follow. A primitive's last index is at prim + 2 * restarts up to
+  //   and including prim, odd primitives within a strip swap their first two indices.
+  //   Strips restart every PACKBASIC_STRIP_RESTART_INTERVAL primitives.
+  //
+  // { ..., u32 restartBits[(numPrimitives + 31) / 32], u8[numPrimitives + 2 * numStrips ...] }
+  //
+  // - optional third sequence after the primitives, quantized positions
+  //   as offsets to the meshlet's minimum on the object's position lattice
+  //
+  // { ..., u32 minX | minY << 16, u32 minZ | bits << 16, bits[numVertices * 3 * bits ...] }
+  //
+  // - optional last sequence, the parts of the primitives when meshlets span
+  //   multiple parts. Each range starts at primBegin and lasts until the next,
+  //   the first range starts at primitive 0 with partDelta 0.
+  //
+  // { ..., u32 basePart | numRanges << 24, u32[numRanges] partDelta | primBegin << 24 }
+  //
+  // - or instead, for meshlets of a lod hierarchy, their MeshletLod
+  //
+  // { ..., f32 bounds[4], f32 parentBounds[4], f32 error, f32 parentError }
 
   union
   {
@@ -200,8 +269,18 @@ struct MeshletPackBasic
     uint8_t  data8[1];
   };
 
+  // delta encoding only, must be set prior to the vertex indices
+  inline void setVertexBase(uint32_t indexValue) { data32[0] = indexValue; }
+
   inline void setVertexIndex(uint32_t PACKED_SIZE, uint32_t vertex, uint32_t vertexPack, uint32_t indexValue)
   {
+    if(vertexPack & PACKBASIC_VERTEX_DELTA)
+    {
+      uint32_t deltaBits = vertexPack & ~PACKBASIC_VERTEX_DELTA;
+      assert(indexValue >= data32[0]);
+      setBitField(PACKED_SIZE - 1, data32 + 1, deltaBits, vertex * deltaBits, indexValue - data32[0]);
+      return;
+    }
 #if 1
     (void)PACKED_SIZE;
     if(vertexPack == 1)
@@ -224,6 +303,14 @@ struct MeshletPackBasic
 
   [[nodiscard]] inline uint32_t getVertexIndex(uint32_t vertex, uint32_t vertexPack) const
   {
+    if(vertexPack & PACKBASIC_VERTEX_DELTA)
+    {
+      uint32_t deltaBits = vertexPack & ~PACKBASIC_VERTEX_DELTA;
+      uint32_t bitOffset = vertex * deltaBits;
+      // only the words covered by this vertex are accessed
+      uint32_t numWords = (bitOffset + deltaBits + 31) / 32;
+      return data32[0] + getBitField(numWords, data32 + 1, deltaBits, bitOffset);
+    }
 #if 1
     return (vertexPack == 1) ? data32[vertex] : data16[vertex];
 #else
@@ -238,6 +325,71 @@ struct MeshletPackBasic
 #endif
   }
 
+  inline void setPositionHeader(uint32_t positionStart, const uint32_t latticeMin[3], uint32_t bits)
+  {
+    data32[positionStart + 0] = latticeMin[0] | (latticeMin[1] << 16);
+    data32[positionStart + 1] = latticeMin[2] | (bits << 16);
+  }
+
+  inline void getPositionHeader(uint32_t positionStart, uint32_t latticeMin[3], uint32_t& bits) const
+  {
+    latticeMin[0] = data32[positionStart + 0] & 0xFFFF;
+    latticeMin[1] = data32[positionStart + 0] >> 16;
+    latticeMin[2] = data32[positionStart + 1] & 0xFFFF;
+    bits          = data32[positionStart + 1] >> 16;
+  }
+
+  // lattice is relative to the header's latticeMin
+  inline void setPosition(uint32_t PACKED_SIZE, uint32_t vertex, uint32_t positionStart, uint32_t bits, const uint32_t lattice[3])
+  {
+    for(uint32_t c = 0; c < 3; c++)
+    {
+      setBitField(PACKED_SIZE - positionStart - 2, data32 + positionStart + 2, bits, (vertex * 3 + c) * bits, lattice[c]);
+    }
+  }
+
+  // returns absolute lattice coordinates
+  inline void getPosition(uint32_t vertex, uint32_t positionStart, uint32_t lattice[3]) const
+  {
+    uint32_t bits;
+    getPositionHeader(positionStart, lattice, bits);
+    for(uint32_t c = 0; c < 3; c++)
+    {
+      uint32_t bitOffset = (vertex * 3 + c) * bits;
+      uint32_t numWords  = (bitOffset + bits + 31) / 32;
+      lattice[c] += getBitField(numWords, data32 + positionStart + 2, bits, bitOffset);
+    }
+  }
+
+  inline void setPartHeader(uint32_t partStart, uint32_t basePart, uint32_t numRanges)
+  {
+    assert(basePart < (1 << 24) && numRanges < 256);
+    data32[partStart] = basePart | (numRanges << 24);
+  }
+
+  inline void setPartRange(uint32_t partStart, uint32_t range, uint32_t partDelta, uint32_t primBegin)
+  {
+    assert(partDelta < (1 << 24) && primBegin < 256);
+    data32[partStart + 1 + range] = partDelta | (primBegin << 24);
+  }
+
+  [[nodiscard]] inline uint32_t getNumPartRanges(uint32_t partStart) const { return data32[partStart] >> 24; }
+
+  [[nodiscard]] inline uint32_t getPrimPart(uint32_t prim, uint32_t partStart) const
+  {
+    uint32_t basePart  = data32[partStart] & 0xFFFFFF;
+    uint32_t numRanges = data32[partStart] >> 24;
+    uint32_t part      = basePart;
+    for(uint32_t r = 0; r < numRanges && prim >= (data32[partStart + 1 + r] >> 24); r++)
+    {
+      part = basePart + (data32[partStart + 1 + r] & 0xFFFFFF);
+    }
+    return part;
+  }
+
+  inline void setLod(uint32_t lodStart, const MeshletLod& lod) { memcpy(data32 + lodStart, &lod, sizeof(MeshletLod)); }
+  inline void getLod(uint32_t lodStart, MeshletLod& lod) const { memcpy(&lod, data32 + lodStart, sizeof(MeshletLod)); }
+
   inline void setPrimIndices(uint32_t PACKED_SIZE, uint32_t prim, uint32_t primStart, const uint8_t indices[3])
   {
     uint32_t idx = primStart * 4 + prim * 3;
@@ -257,45 +409,131 @@ struct MeshletPackBasic
     indices[1] = data8[idx + 1];
     indices[2] = data8[idx + 2];
   }
+
+  [[nodiscard]] inline uint32_t getNumPrimStrips(const MeshletPackBasicDesc& meshlet) const
+  {
+    uint32_t primStart = meshlet.getPrimStart();
+    uint32_t numStrips = 0;
+    for(uint32_t w = 0; w < meshlet.getPrimStripRestartWords(); w++)
+    {
+      numStrips += bitCount(data32[primStart + w]);
+    }
+    return numStrips;
+  }
+
+  // same decoding as the mesh shaders
+  inline void getPrimStripIndices(const MeshletPackBasicDesc& meshlet, uint32_t prim, uint8_t indices[3]) const
+  {
+    uint32_t primStart = meshlet.getPrimStart();
+    uint32_t word      = prim / PACKBASIC_STRIP_RESTART_INTERVAL;
+    uint32_t restarts  = 0;
+    for(uint32_t w = 0; w < word; w++)
+    {
+      restarts += bitCount(data32[primStart + w]);
+    }
+
+    uint32_t bit      = prim % PACKBASIC_STRIP_RESTART_INTERVAL;
+    uint32_t bits     = data32[primStart + word] & (~0u >> (31 - bit));
+    uint32_t stripBit = 31 - countLeadingZeros(bits);
+    restarts += bitCount(bits);
+
+    uint32_t idx  = (primStart + meshlet.getPrimStripRestartWords()) * 4 + prim + restarts * 2;
+    bool     flip = ((bit - stripBit) & 1) != 0;
+
+    indices[0] = data8[idx - (flip ? 1 : 2)];
+    indices[1] = data8[idx - (flip ? 2 : 1)];
+    indices[2] = data8[idx];
+  }
+
+  inline void getPrimIndices(const MeshletPackBasicDesc& meshlet, uint32_t prim, uint8_t indices[3]) const
+  {
+    if(meshlet.hasPrimStrips())
+    {
+      getPrimStripIndices(meshlet, prim, indices);
+    }
+    else
+    {
+      getPrimIndices(prim, meshlet.getPrimStart(), indices);
+    }
+  }
+
+  [[nodiscard]] inline uint32_t getPrimSize(const MeshletPackBasicDesc& meshlet) const
+  {
+    if(meshlet.hasPrimStrips())
+    {
+      uint32_t numIndices = meshlet.getNumPrims() + getNumPrimStrips(meshlet) * 2;
+      return meshlet.getPrimStripRestartWords() + (numIndices + 3) / 4;
+    }
+    return meshlet.getPrimSize();
+  }
+
+  // optional quantized positions, see PackBasicBuilder::buildMeshletPositions
+  [[nodiscard]] inline uint32_t getPositionStart(const MeshletPackBasicDesc& meshlet) const
+  {
+    return meshlet.getPrimStart() + getPrimSize(meshlet);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// Builder output
+// The provided builder functions operate on one triangle mesh at a time
+// and generate these outputs. Shared by all PackBasicBuilderT instances.
+
+struct PackBasicMeshletGeometry
+{
+  std::vector<PackBasicType>        meshletPacks;
+  std::vector<MeshletPackBasicDesc> meshletDescriptors;
+  std::vector<MeshletBbox>          meshletBboxes;
+  // non-zero if packs contain quantized positions
+  uint32_t positionLatticeBits = 0;
+  // packs contain the parts of their primitives
+  bool mergedParts = false;
 };
 
-class PackBasicBuilder
+// MAX_VERTICES and MAX_PRIMITIVES size the builder's working arrays
+// (primitive cache, early culling scratch), the limits passed to setup
+// must not exceed them. Instances matching the common setup limits keep
+// these arrays small enough to stay within L1, see dispatchPackBasicBuilder.
+
+template <uint32_t MAX_VERTICES = MAX_VERTEX_COUNT_LIMIT, uint32_t MAX_PRIMITIVES = MAX_PRIMITIVE_COUNT_LIMIT>
+class PackBasicBuilderT
 {
 public:
-  //////////////////////////////////////////////////////////////////////////
-  // Builder output
-  // The provided builder functions operate on one triangle mesh at a time
-  // and generate these outputs.
+  typedef PackBasicMeshletGeometry MeshletGeometry;
 
-  struct MeshletGeometry
-  {
-    std::vector<PackBasicType>        meshletPacks;
-    std::vector<MeshletPackBasicDesc> meshletDescriptors;
-    std::vector<MeshletBbox>          meshletBboxes;
-  };
+  static_assert(MAX_VERTICES <= MAX_VERTEX_COUNT_LIMIT, "MAX_VERTICES exceeds MAX_VERTEX_COUNT_LIMIT");
+  static_assert(MAX_PRIMITIVES <= MAX_PRIMITIVE_COUNT_LIMIT, "MAX_PRIMITIVES exceeds MAX_PRIMITIVE_COUNT_LIMIT");
 
+private:
+  // scratch arrays are padded to full SIMD lanes
+  static const uint32_t VERTEX_CAPACITY    = (MAX_VERTICES + 7) & ~7u;
+  static const uint32_t PRIMITIVE_CAPACITY = (MAX_PRIMITIVES + 7) & ~7u;
 
   //////////////////////////////////////////////////////////////////////////
   // Builder configuration
-private:
-  // might want to template these instead of using MAX
+
   uint32_t m_maxVertexCount;
   uint32_t m_maxPrimitiveCount;
   bool     m_separateBboxes;
+  bool     m_deltaVertices;
 
   // due to hw allocation granuarlity, good values are
   // vertex count = 32 or 64
   // primitive count = 40, 84 or 126
   //                   maximizes the fit into gl_PrimitiveIndices[128 * N - 4]
+  //
+  // deltaVertices stores vertex indices as base + bit-packed deltas
+  // (NVMESHLET_ENCODING_PACKDELTA) instead of 16 or 32 bit values
 public:
-  void setup(uint32_t maxVertexCount, uint32_t maxPrimitiveCount, bool separateBboxes = false)
+  void setup(uint32_t maxVertexCount, uint32_t maxPrimitiveCount, bool separateBboxes = false, bool deltaVertices = false)
   {
-    assert(maxPrimitiveCount <= MAX_PRIMITIVE_COUNT_LIMIT);
-    assert(maxVertexCount <= MAX_VERTEX_COUNT_LIMIT);
+    assert(maxPrimitiveCount <= MAX_PRIMITIVES);
+    assert(maxVertexCount <= MAX_VERTICES);
 
     m_maxVertexCount    = maxVertexCount;
     m_maxPrimitiveCount = maxPrimitiveCount;
     m_separateBboxes    = separateBboxes;
+    m_deltaVertices     = deltaVertices;
 
     {
       uint32_t indices = maxPrimitiveCount * 3;
@@ -308,13 +546,78 @@ public:
     }
   }
 
+  // Reserves the outputs for building numIndices triangle indices, so that
+  // addMeshlet does not regrow the packs one meshlet at a time.
+  // Upper bound for triangle lists: a meshlet is only closed once the next
+  // triangle does not fit, so all but the last one hold at least
+  // min(maxPrimitives, maxVertices / 3) triangles, even for triangle soups.
+  // maxVertex selects between 16 and 32 bit vertex indices.
+  void reserveMeshlets(MeshletGeometry& geometry, uint32_t numIndices, uint32_t maxVertex) const
+  {
+    uint32_t numTris     = numIndices / 3;
+    uint32_t minPrims    = std::min(m_maxPrimitiveCount, std::max(1u, m_maxVertexCount / 3));
+    uint32_t numMeshlets = (numTris + minPrims - 1) / minPrims;
+
+    // vertex deltas never need more bits than maxVertex itself
+    uint32_t vertexBits = maxVertex <= 0xFFFF ? 16 : 32;
+    if(m_deltaVertices)
+    {
+      vertexBits = 1;
+      while(vertexBits < 32 && (maxVertex >> vertexBits))
+      {
+        vertexBits++;
+      }
+    }
+
+    // per meshlet: rounding of the vertex, prim start and prim sizes, delta base and alignment
+    size_t overhead    = 4 + PACKBASIC_ALIGN - 1;
+    size_t numVertices = std::min(size_t(numTris) * 3, size_t(numMeshlets) * m_maxVertexCount);
+    size_t packedTotal = size_t(numMeshlets) * overhead + numVertices * vertexBits / 32 + (size_t(numTris) * 3 + 3) / 4;
+
+    // never more than full meshlets
+    MeshletPackBasicDesc meshlet;
+    meshlet.setNumPrims(m_maxPrimitiveCount);
+    meshlet.setNumVertices(m_maxVertexCount);
+    meshlet.setNumVertexPack(vertexBits <= 16 ? 2 : 1);
+
+    size_t packedFull = size_t(numMeshlets) * alignedSize(meshlet.getPrimStart() + meshlet.getPrimSize() + 1, PACKBASIC_ALIGN);
+
+    geometry.meshletPacks.reserve(geometry.meshletPacks.size() + std::min(packedTotal, packedFull));
+    geometry.meshletDescriptors.reserve(geometry.meshletDescriptors.size() + numMeshlets);
+  }
+
   //////////////////////////////////////////////////////////////////////////
   // generate meshlets
 private:
-  static void addMeshlet(MeshletGeometry& geometry, const PrimitiveCache& cache)
+  template <class Cache>
+  static void addMeshlet(MeshletGeometry& geometry, const Cache& cache, bool deltaVertices)
   {
     uint32_t packOffset = uint32_t(geometry.meshletPacks.size());
     uint32_t vertexPack = cache.numVertexAllBits <= 16 ? 2 : 1;
+    uint32_t vertexBase = 0;
+
+    if(deltaVertices)
+    {
+      uint32_t vertexMin = ~0u;
+      uint32_t vertexMax = 0;
+      for(uint32_t v = 0; v < cache.numVertices; v++)
+      {
+        vertexMin = std::min(vertexMin, cache.vertices[v]);
+        vertexMax = std::max(vertexMax, cache.vertices[v]);
+      }
+
+      // at most 31 bits, setBitField/getBitField cannot shift by the full word width,
+      // and the shaders decode all meshlets as deltas, so there is no plain fallback
+      uint32_t deltaBits = 1;
+      while(deltaBits < 31 && ((vertexMax - vertexMin) >> deltaBits))
+      {
+        deltaBits++;
+      }
+      assert(((vertexMax - vertexMin) >> deltaBits) == 0);
+
+      vertexPack = PACKBASIC_VERTEX_DELTA | deltaBits;
+      vertexBase = vertexMin;
+    }
 
     MeshletPackBasicDesc meshlet;
     meshlet.setNumPrims(cache.numPrims);
@@ -337,6 +640,11 @@ private:
     auto* pack = (MeshletPackBasic*)&geometry.meshletPacks[packOffset];
 
     {
+      if(deltaVertices)
+      {
+        pack->setVertexBase(vertexBase);
+      }
+
       for(uint32_t v = 0; v < cache.numVertices; v++)
       {
         pack->setVertexIndex(packedSize, v, vertexPack, cache.vertices[v]);
@@ -355,13 +663,15 @@ public:
   // Returns the number of successfully processed indices.
   // If the returned number is lower than provided input, use the number
   // as starting offset and create a new geometry description.
-  template <class VertexIndexType>
+  // LOOKUP selects the vertex lookup strategy of the cache, the output is
+  // identical for all of them.
+  template <class VertexIndexType, PrimitiveCacheLookup LOOKUP = PRIMITIVE_CACHE_LOOKUP_DEFAULT>
   uint32_t buildMeshlets(MeshletGeometry& geometry, const uint32_t numIndices, const VertexIndexType* NV_RESTRICT indices) const
   {
-    assert(m_maxPrimitiveCount <= MAX_PRIMITIVE_COUNT_LIMIT);
-    assert(m_maxVertexCount <= MAX_VERTEX_COUNT_LIMIT);
+    assert(m_maxPrimitiveCount <= MAX_PRIMITIVES);
+    assert(m_maxVertexCount <= MAX_VERTICES);
 
-    PrimitiveCache cache;
+    PrimitiveCacheT<LOOKUP, MAX_VERTICES, MAX_PRIMITIVES> cache;
     cache.maxPrimitiveSize = m_maxPrimitiveCount;
     cache.maxVertexSize    = m_maxVertexCount;
     cache.reset();
@@ -371,237 +681,1052 @@ public:
       if(cache.cannotInsertBlock(indices[i * 3 + 0], indices[i * 3 + 1], indices[i * 3 + 2]))
       {
         // finish old and reset
-        addMeshlet(geometry, cache);
+        addMeshlet(geometry, cache, m_deltaVertices);
         cache.reset();
       }
       cache.insert(indices[i * 3 + 0], indices[i * 3 + 1], indices[i * 3 + 2]);
     }
     if(!cache.empty())
     {
-      addMeshlet(geometry, cache);
+      addMeshlet(geometry, cache, m_deltaVertices);
     }
 
     return numIndices;
   }
 
-
-  static void padTaskMeshlets(MeshletGeometry& geometry)
-  {
-    if(geometry.meshletDescriptors.empty())
-      return;
-  }
-
-  //////////////////////////////////////////////////////////////////////////
-  // generate early culling per meshlet
-
-public:
-  // bbox and cone angle
-  void buildMeshletEarlyCulling(MeshletGeometry&         geometry,
-                                const float              objectBboxMin[3],
-                                const float              objectBboxMax[3],
-                                const float* NV_RESTRICT positions,
-                                const size_t             positionStride) const
+  // Alternative to buildMeshlets that does not follow the order of the
+  // index buffer. Each meshlet is grown greedily over the triangle
+  // adjacency, preferring the candidate that shares the most vertices
+  // with the meshlet and then the one closest to its centroid. This
+  // results in spatially compact meshlets with tighter bboxes and
+  // normal cones. Degenerate triangles are skipped.
+  // Always processes all indices.
+  template <class VertexIndexType>
+  uint32_t buildMeshletsSpatial(MeshletGeometry&                   geometry,
+                                const uint32_t                     numIndices,
+                                const VertexIndexType* NV_RESTRICT indices,
+                                const float* NV_RESTRICT           positions,
+                                const size_t                       positionStride) const
   {
+    assert(m_maxPrimitiveCount <= MAX_PRIMITIVES);
+    assert(m_maxVertexCount <= MAX_VERTICES);
     assert((positionStride % sizeof(float)) == 0);
 
-    size_t positionMul = positionStride / sizeof(float);
-
-    vec objectBboxExtent = vec(objectBboxMax) - vec(objectBboxMin);
+    size_t   positionMul = positionStride / sizeof(float);
+    uint32_t numTris     = numIndices / 3;
 
-    if(m_separateBboxes)
+    if(!numTris)
     {
-      geometry.meshletBboxes.resize(geometry.meshletDescriptors.size());
+      return numIndices;
     }
 
-    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    uint32_t minVertex = ~0u;
+    uint32_t maxVertex = 0;
+    for(uint32_t i = 0; i < numTris * 3; i++)
     {
-      MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
-      const auto*           pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
-
-      uint32_t primCount   = meshlet.getNumPrims();
-      uint32_t primStart   = meshlet.getPrimStart();
-      uint32_t vertexCount = meshlet.getNumVertices();
-      uint32_t vertexPack  = meshlet.getNumVertexPack();
-
-      vec bboxMin = vec(FLT_MAX);
-      vec bboxMax = vec(-FLT_MAX);
+      minVertex = std::min(minVertex, uint32_t(indices[i]));
+      maxVertex = std::max(maxVertex, uint32_t(indices[i]));
+    }
 
-      vec avgNormal = vec(0.0f);
-      vec triNormals[MAX_PRIMITIVE_COUNT_LIMIT];
+    // vertex to triangle adjacency, relative to minVertex
 
-      // skip unset
-      if(vertexCount == 1)
-        continue;
+    uint32_t              numVertices = maxVertex - minVertex + 1;
+    std::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    std::vector<uint32_t> adjacencyTris(numTris * 3);
 
-      for(uint32_t p = 0; p < primCount; p++)
+    for(uint32_t i = 0; i < numTris * 3; i++)
+    {
+      adjacencyOffsets[indices[i] - minVertex + 1]++;
+    }
+    for(uint32_t v = 0; v < numVertices; v++)
+    {
+      adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    {
+      std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for(uint32_t i = 0; i < numTris * 3; i++)
       {
-        uint8_t  indices[3];
-        uint32_t idxA;
-        uint32_t idxB;
-        uint32_t idxC;
-
-        pack->getPrimIndices(p, primStart, indices);
-        idxA = pack->getVertexIndex(indices[0], vertexPack);
-        idxB = pack->getVertexIndex(indices[1], vertexPack);
-        idxC = pack->getVertexIndex(indices[2], vertexPack);
-
-        vec posA = vec(&positions[idxA * positionMul]);
-        vec posB = vec(&positions[idxB * positionMul]);
-        vec posC = vec(&positions[idxC * positionMul]);
-
-        {
-          // bbox
-          bboxMin = vec_min(bboxMin, posA);
-          bboxMin = vec_min(bboxMin, posB);
-          bboxMin = vec_min(bboxMin, posC);
-
-          bboxMax = vec_max(bboxMax, posA);
-          bboxMax = vec_max(bboxMax, posB);
-          bboxMax = vec_max(bboxMax, posC);
-        }
-
-        {
-          // cone
-          vec   cross  = vec_cross(posB - posA, posC - posA);
-          float length = vec_length(cross);
+        adjacencyTris[fill[indices[i] - minVertex]++] = i / 3;
+      }
+    }
 
-          vec normal;
-          if(length > FLT_EPSILON)
-          {
-            normal = cross * (1.0f / length);
-          }
-          else
-          {
-            normal = cross;
-          }
+    std::vector<vec>      centroids(numTris);
+    std::vector<uint8_t>  used(numTris, 0);
+    std::vector<uint32_t> candidateStamps(numTris, 0);
+    uint32_t              numRemaining = 0;
 
-          avgNormal     = avgNormal + normal;
-          triNormals[p] = normal;
-        }
-      }
+    for(uint32_t t = 0; t < numTris; t++)
+    {
+      uint32_t idxA = indices[t * 3 + 0];
+      uint32_t idxB = indices[t * 3 + 1];
+      uint32_t idxC = indices[t * 3 + 2];
 
-      if(m_separateBboxes)
+      if(idxA == idxB || idxA == idxC || idxB == idxC)
       {
-        geometry.meshletBboxes[i].bboxMin[0] = bboxMin.x;
-        geometry.meshletBboxes[i].bboxMin[1] = bboxMin.y;
-        geometry.meshletBboxes[i].bboxMin[2] = bboxMin.z;
-        geometry.meshletBboxes[i].bboxMax[0] = bboxMax.x;
-        geometry.meshletBboxes[i].bboxMax[1] = bboxMax.y;
-        geometry.meshletBboxes[i].bboxMax[2] = bboxMax.z;
+        used[t] = 1;
+        continue;
       }
 
-      {
-        // bbox
-        // truncate min relative to object min
-        bboxMin = bboxMin - vec(objectBboxMin);
-        bboxMax = bboxMax - vec(objectBboxMin);
-        bboxMin = bboxMin / objectBboxExtent;
-        bboxMax = bboxMax / objectBboxExtent;
+      centroids[t] = (vec(positions + idxA * positionMul) + vec(positions + idxB * positionMul)
+                      + vec(positions + idxC * positionMul))
+                     * (1.0f / 3.0f);
+      numRemaining++;
+    }
 
-        // snap to grid
-        const int gridBits = 8;
-        const int gridLast = (1 << gridBits) - 1;
-        uint8_t   gridMin[3];
-        uint8_t   gridMax[3];
+    PrimitiveCacheT<PRIMITIVE_CACHE_LOOKUP_DEFAULT, MAX_VERTICES, MAX_PRIMITIVES> cache;
+    cache.maxPrimitiveSize = m_maxPrimitiveCount;
+    cache.maxVertexSize    = m_maxVertexCount;
+    cache.reset();
 
-        gridMin[0] = std::max(0, std::min(int(truncf(bboxMin.x * float(gridLast))), gridLast - 1));
-        gridMin[1] = std::max(0, std::min(int(truncf(bboxMin.y * float(gridLast))), gridLast - 1));
-        gridMin[2] = std::max(0, std::min(int(truncf(bboxMin.z * float(gridLast))), gridLast - 1));
-        gridMax[0] = std::max(0, std::min(int(ceilf(bboxMax.x * float(gridLast))), gridLast));
-        gridMax[1] = std::max(0, std::min(int(ceilf(bboxMax.y * float(gridLast))), gridLast));
-        gridMax[2] = std::max(0, std::min(int(ceilf(bboxMax.z * float(gridLast))), gridLast));
+    std::vector<uint32_t> candidates;
+    uint32_t              candidateStamp = 1;
+    uint32_t              seed           = 0;
+    vec                   centroidSum;
 
-        meshlet.setBBox(gridMin, gridMax);
-      }
+    while(numRemaining)
+    {
+      uint32_t best       = ~0u;
+      uint32_t bestShared = 0;
+      float    bestDist   = FLT_MAX;
+      vec      center     = cache.numPrims ? centroidSum * (1.0f / float(cache.numPrims)) : vec();
 
+      for(size_t c = 0; c < candidates.size();)
       {
-        // potential improvement, instead of average maybe use
-        // http://www.cs.technion.ac.il/~cggc/files/gallery-pdfs/Barequet-1.pdf
-
-        float len = vec_length(avgNormal);
-        if(len > FLT_EPSILON)
+        uint32_t t = candidates[c];
+        if(used[t])
         {
-          avgNormal = avgNormal / len;
-        }
-        else
-        {
-          avgNormal = vec(0.0f);
+          candidates[c] = candidates.back();
+          candidates.pop_back();
+          continue;
         }
 
-        vec  packed = float32x3_to_octn_precise(avgNormal, 16);
-        auto coneX  = static_cast<int8_t>(std::min(127, std::max(-127, int32_t(packed.x * 127.0f))));
-        auto coneY  = static_cast<int8_t>(std::min(127, std::max(-127, int32_t(packed.y * 127.0f))));
+        const uint32_t tri[3] = {uint32_t(indices[t * 3 + 0]), uint32_t(indices[t * 3 + 1]), uint32_t(indices[t * 3 + 2])};
 
-        // post quantization normal
-        avgNormal = oct_to_float32x3(vec(float(coneX) / 127.0f, float(coneY) / 127.0f, 0.0f));
+        uint32_t shared = cache.countFound(tri);
+        vec      delta  = centroids[t] - center;
+        float    dist   = vec_dot(delta, delta);
+        if(best == ~0u || shared > bestShared || (shared == bestShared && dist < bestDist))
+        {
+          best       = t;
+          bestShared = shared;
+          bestDist   = dist;
+        }
+        c++;
+      }
 
-        float mindot = 1.0f;
-        for(unsigned int p = 0; p < primCount; p++)
+      if(best == ~0u)
+      {
+        // no connected triangle left, continue with the next one in index order
+        while(used[seed])
         {
-          mindot = std::min(mindot, vec_dot(triNormals[p], avgNormal));
+          seed++;
         }
+        best = seed;
+      }
 
-        // apply safety delta due to quantization
-        mindot -= 1.0f / 127.0f;
-        mindot = std::max(-1.0f, mindot);
+      uint32_t idxA = indices[best * 3 + 0];
+      uint32_t idxB = indices[best * 3 + 1];
+      uint32_t idxC = indices[best * 3 + 2];
 
-        // positive value for cluster not being backface cullable (normals > 90°)
-        int8_t coneAngle = 127;
-        if(mindot > 0)
+      if(cache.cannotInsertBlock(idxA, idxB, idxC))
+      {
+        // finish old and reset, the rejected triangle seeds the next meshlet
+        addMeshlet(geometry, cache, m_deltaVertices);
+        cache.reset();
+        candidates.clear();
+        candidateStamp++;
+        centroidSum = vec();
+      }
+      cache.insert(idxA, idxB, idxC);
+
+      used[best] = 1;
+      numRemaining--;
+      centroidSum = centroidSum + centroids[best];
+
+      const uint32_t tri[3] = {idxA, idxB, idxC};
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        uint32_t v = tri[k] - minVertex;
+        for(uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; a++)
         {
-          // otherwise store -sin(cone angle)
-          // we test against dot product (cosine) so this is equivalent to cos(cone angle + 90°)
-          float angle = -sinf(acosf(mindot));
-          coneAngle   = static_cast<int8_t>(std::max(-127, std::min(127, int32_t(angle * 127.0f))));
+          uint32_t t = adjacencyTris[a];
+          if(!used[t] && candidateStamps[t] != candidateStamp)
+          {
+            candidateStamps[t] = candidateStamp;
+            candidates.push_back(t);
+          }
         }
-
-        meshlet.setCone(coneX, coneY, coneAngle);
       }
     }
+    if(!cache.empty())
+    {
+      addMeshlet(geometry, cache, m_deltaVertices);
+    }
+
+    return numIndices;
   }
 
+public:
   //////////////////////////////////////////////////////////////////////////
+  // Appends invalid (all zero) descriptors until the number of meshlets is a
+  // multiple of taskMeshlets (NVMESHLET_PER_TASK). Calling this before the
+  // meshlets of each part are added aligns every part to task workgroups, so
+  // that joined draws of consecutive parts never need a workgroup that
+  // straddles two parts. Shaders skip the padding via isMeshletValid.
 
-  template <class VertexIndexType>
-  StatusCode errorCheck(const MeshletGeometry&             geometry,
-                        uint32_t                           minVertex,
-                        uint32_t                           maxVertex,
-                        uint32_t                           numIndices,
-                        const VertexIndexType* NV_RESTRICT indices) const
+  static void padTaskMeshlets(MeshletGeometry& geometry, uint32_t taskMeshlets)
   {
-    uint32_t compareTris = 0;
+    if(geometry.meshletDescriptors.empty() || !taskMeshlets)
+      return;
 
-    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    size_t numMeshlets = ((geometry.meshletDescriptors.size() + taskMeshlets - 1) / taskMeshlets) * taskMeshlets;
+
+    geometry.meshletDescriptors.resize(numMeshlets);
+    if(!geometry.meshletBboxes.empty())
     {
-      const MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
-      const MeshletPackBasic*     pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+      geometry.meshletBboxes.resize(numMeshlets);
+    }
+  }
 
-      uint32_t primCount   = meshlet.getNumPrims();
-      uint32_t primStart   = meshlet.getPrimStart();
-      uint32_t vertexCount = meshlet.getNumVertices();
-      uint32_t vertexPack  = meshlet.getNumVertexPack();
+  //////////////////////////////////////////////////////////////////////////
+  // Appends the meshlets of "other" and fixes up their pack offsets.
+  // Allows building subsets of a mesh's indices concurrently and stitching
+  // the results together in order afterwards.
+  // Both must have been processed by the same build functions.
 
-      // skip unset
-      if(vertexCount == 1)
-        continue;
+  static void appendGeometry(MeshletGeometry& geometry, const MeshletGeometry& other)
+  {
+    assert(geometry.meshletDescriptors.empty() || geometry.positionLatticeBits == other.positionLatticeBits);
+    assert(geometry.meshletDescriptors.empty() || geometry.mergedParts == other.mergedParts);
+    assert(geometry.meshletBboxes.size() == (geometry.meshletBboxes.empty() ? 0 : geometry.meshletDescriptors.size()));
 
-      for(uint32_t p = 0; p < primCount; p++)
-      {
-        uint8_t blockIndices[3];
-        pack->getPrimIndices(p, primStart, blockIndices);
+    uint32_t packOffset = uint32_t(geometry.meshletPacks.size());
+    size_t   descBegin  = geometry.meshletDescriptors.size();
 
-        if(blockIndices[0] >= m_maxVertexCount || blockIndices[1] >= m_maxVertexCount || blockIndices[2] >= m_maxVertexCount)
-        {
-          return STATUS_PRIM_OUT_OF_BOUNDS;
-        }
+    geometry.meshletPacks.insert(geometry.meshletPacks.end(), other.meshletPacks.begin(), other.meshletPacks.end());
+    geometry.meshletDescriptors.insert(geometry.meshletDescriptors.end(), other.meshletDescriptors.begin(),
+                                       other.meshletDescriptors.end());
+    geometry.meshletBboxes.insert(geometry.meshletBboxes.end(), other.meshletBboxes.begin(), other.meshletBboxes.end());
+    geometry.positionLatticeBits = other.positionLatticeBits;
+    geometry.mergedParts         = other.mergedParts;
 
-        uint32_t idxA = pack->getVertexIndex(blockIndices[0], vertexPack);
-        uint32_t idxB = pack->getVertexIndex(blockIndices[1], vertexPack);
-        uint32_t idxC = pack->getVertexIndex(blockIndices[2], vertexPack);
+    for(size_t i = descBegin; i < geometry.meshletDescriptors.size(); i++)
+    {
+      MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+      meshlet.setPackOffset(meshlet.getPackOffset() + packOffset);
+    }
+  }
 
-        if(idxA < minVertex || idxA > maxVertex || idxB < minVertex || idxB > maxVertex || idxC < minVertex || idxC > maxVertex)
-        {
-          return STATUS_VERTEX_OUT_OF_BOUNDS;
+  //////////////////////////////////////////////////////////////////////////
+  // generate early culling per meshlet
+
+public:
+  // bbox and cone angle
+  // Meshlets are processed concurrently when OpenMP is enabled.
+  template <EarlyCullingMode MODE = EARLY_CULLING_DEFAULT>
+  void buildMeshletEarlyCulling(MeshletGeometry&         geometry,
+                                const float              objectBboxMin[3],
+                                const float              objectBboxMax[3],
+                                const float* NV_RESTRICT positions,
+                                const size_t             positionStride) const
+  {
+#if !NVMESHLET_CACHE_AVX2
+    static_assert(MODE != EARLY_CULLING_AVX2, "AVX2 early culling requires compiling with AVX2 support");
+#endif
+#if !NVMESHLET_CACHE_SSE2
+    static_assert(MODE != EARLY_CULLING_SSE2, "SSE2 early culling requires compiling with SSE2 support");
+#endif
+    assert((positionStride % sizeof(float)) == 0);
+
+    size_t positionMul = positionStride / sizeof(float);
+
+    vec objectBboxExtent = vec(objectBboxMax) - vec(objectBboxMin);
+
+    if(m_separateBboxes)
+    {
+      geometry.meshletBboxes.resize(geometry.meshletDescriptors.size());
+    }
+
+    int numMeshlets = int(geometry.meshletDescriptors.size());
+
+#pragma omp parallel for schedule(dynamic, 64) if(numMeshlets >= 1024)
+    for(int i = 0; i < numMeshlets; i++)
+    {
+#if NVMESHLET_CACHE_AVX2
+      if constexpr(MODE == EARLY_CULLING_AVX2)
+      {
+        buildEarlyCullingSimd<SimdFloat8>(geometry, i, objectBboxMin, objectBboxExtent, positions, positionMul);
+        continue;
+      }
+#endif
+#if NVMESHLET_CACHE_SSE2
+      if constexpr(MODE == EARLY_CULLING_SSE2)
+      {
+        buildEarlyCullingSimd<SimdFloat4>(geometry, i, objectBboxMin, objectBboxExtent, positions, positionMul);
+        continue;
+      }
+#endif
+      buildEarlyCullingScalar(geometry, i, objectBboxMin, objectBboxExtent, positions, positionMul);
+    }
+  }
+
+private:
+  void buildEarlyCullingScalar(MeshletGeometry&         geometry,
+                               size_t                   i,
+                               const float              objectBboxMin[3],
+                               const vec&               objectBboxExtent,
+                               const float* NV_RESTRICT positions,
+                               const size_t             positionMul) const
+  {
+    MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+    const auto*           pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+    uint32_t primCount   = meshlet.getNumPrims();
+    uint32_t vertexCount = meshlet.getNumVertices();
+    uint32_t vertexPack  = meshlet.getNumVertexPack();
+    assert(primCount <= MAX_PRIMITIVES);
+
+    vec bboxMin = vec(FLT_MAX);
+    vec bboxMax = vec(-FLT_MAX);
+
+    vec avgNormal = vec(0.0f);
+    vec triNormals[MAX_PRIMITIVES];
+
+    // skip unset
+    if(vertexCount == 1)
+      return;
+
+    for(uint32_t p = 0; p < primCount; p++)
+    {
+      uint8_t  indices[3];
+      uint32_t idxA;
+      uint32_t idxB;
+      uint32_t idxC;
+
+      pack->getPrimIndices(meshlet, p, indices);
+      idxA = pack->getVertexIndex(indices[0], vertexPack);
+      idxB = pack->getVertexIndex(indices[1], vertexPack);
+      idxC = pack->getVertexIndex(indices[2], vertexPack);
+
+      vec posA = vec(&positions[idxA * positionMul]);
+      vec posB = vec(&positions[idxB * positionMul]);
+      vec posC = vec(&positions[idxC * positionMul]);
+
+      {
+        // bbox
+        bboxMin = vec_min(bboxMin, posA);
+        bboxMin = vec_min(bboxMin, posB);
+        bboxMin = vec_min(bboxMin, posC);
+
+        bboxMax = vec_max(bboxMax, posA);
+        bboxMax = vec_max(bboxMax, posB);
+        bboxMax = vec_max(bboxMax, posC);
+      }
+
+      {
+        // cone
+        vec   cross  = vec_cross(posB - posA, posC - posA);
+        float length = vec_length(cross);
+
+        vec normal;
+        if(length > FLT_EPSILON)
+        {
+          normal = cross * (1.0f / length);
+        }
+        else
+        {
+          normal = cross;
+        }
+
+        avgNormal     = avgNormal + normal;
+        triNormals[p] = normal;
+      }
+    }
+
+    setEarlyCullingBbox(geometry, i, bboxMin, bboxMax, objectBboxMin, objectBboxExtent);
+
+    int8_t coneX;
+    int8_t coneY;
+    avgNormal = quantizeConeNormal(avgNormal, coneX, coneY);
+
+    float mindot = 1.0f;
+    for(unsigned int p = 0; p < primCount; p++)
+    {
+      mindot = std::min(mindot, vec_dot(triNormals[p], avgNormal));
+    }
+
+    meshlet.setCone(coneX, coneY, computeConeAngle(mindot));
+  }
+
+  // Same results as buildEarlyCullingScalar: the meshlet's vertices are gathered
+  // once into structure-of-arrays scratch, then the triangles are processed
+  // Simd::LANES at a time. Per-lane math mirrors the scalar operation order,
+  // min/max are order independent, and the average normal is summed sequentially.
+  template <class Simd>
+  void buildEarlyCullingSimd(MeshletGeometry&         geometry,
+                             size_t                   i,
+                             const float              objectBboxMin[3],
+                             const vec&               objectBboxExtent,
+                             const float* NV_RESTRICT positions,
+                             const size_t             positionMul) const
+  {
+    typedef typename Simd::type vtype;
+    const uint32_t              LANES = Simd::LANES;
+
+    MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+    const auto*           pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+    uint32_t primCount   = meshlet.getNumPrims();
+    uint32_t vertexCount = meshlet.getNumVertices();
+    uint32_t vertexPack  = meshlet.getNumVertexPack();
+    assert(vertexCount <= MAX_VERTICES && primCount <= MAX_PRIMITIVES);
+
+    // skip unset
+    if(vertexCount == 1)
+      return;
+
+    alignas(32) float vertexPos[3][VERTEX_CAPACITY];
+    for(uint32_t v = 0; v < vertexCount; v++)
+    {
+      const float* pos = &positions[pack->getVertexIndex(v, vertexPack) * positionMul];
+      vertexPos[0][v]  = pos[0];
+      vertexPos[1][v]  = pos[1];
+      vertexPos[2][v]  = pos[2];
+    }
+
+    // corners [A,B,C][x,y,z], padded to full lanes by repeating the first triangle
+    uint32_t          primPadded = ((primCount + LANES - 1) / LANES) * LANES;
+    alignas(32) float cornerPos[3][3][PRIMITIVE_CAPACITY];
+    for(uint32_t p = 0; p < primPadded; p++)
+    {
+      uint8_t indices[3];
+      pack->getPrimIndices(meshlet, p < primCount ? p : 0, indices);
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        cornerPos[k][0][p] = vertexPos[0][indices[k]];
+        cornerPos[k][1][p] = vertexPos[1][indices[k]];
+        cornerPos[k][2][p] = vertexPos[2][indices[k]];
+      }
+    }
+
+    alignas(32) float triNormals[3][PRIMITIVE_CAPACITY];
+
+    vtype bboxMin[3] = {Simd::set1(FLT_MAX), Simd::set1(FLT_MAX), Simd::set1(FLT_MAX)};
+    vtype bboxMax[3] = {Simd::set1(-FLT_MAX), Simd::set1(-FLT_MAX), Simd::set1(-FLT_MAX)};
+
+    for(uint32_t p = 0; p < primPadded; p += LANES)
+    {
+      vtype posA[3];
+      vtype posB[3];
+      vtype posC[3];
+      for(uint32_t c = 0; c < 3; c++)
+      {
+        posA[c] = Simd::load(&cornerPos[0][c][p]);
+        posB[c] = Simd::load(&cornerPos[1][c][p]);
+        posC[c] = Simd::load(&cornerPos[2][c][p]);
+
+        bboxMin[c] = Simd::min(bboxMin[c], Simd::min(posA[c], Simd::min(posB[c], posC[c])));
+        bboxMax[c] = Simd::max(bboxMax[c], Simd::max(posA[c], Simd::max(posB[c], posC[c])));
+      }
+
+      vtype edgeB[3] = {Simd::sub(posB[0], posA[0]), Simd::sub(posB[1], posA[1]), Simd::sub(posB[2], posA[2])};
+      vtype edgeC[3] = {Simd::sub(posC[0], posA[0]), Simd::sub(posC[1], posA[1]), Simd::sub(posC[2], posA[2])};
+
+      vtype cross[3] = {Simd::sub(Simd::mul(edgeB[1], edgeC[2]), Simd::mul(edgeB[2], edgeC[1])),
+                        Simd::sub(Simd::mul(edgeB[2], edgeC[0]), Simd::mul(edgeB[0], edgeC[2])),
+                        Simd::sub(Simd::mul(edgeB[0], edgeC[1]), Simd::mul(edgeB[1], edgeC[0]))};
+
+      vtype length = Simd::sqrt(Simd::add(Simd::add(Simd::mul(cross[0], cross[0]), Simd::mul(cross[1], cross[1])),
+                                          Simd::mul(cross[2], cross[2])));
+      vtype lengthRcp = Simd::div(Simd::set1(1.0f), length);
+      vtype useNormal = Simd::cmpgt(length, Simd::set1(FLT_EPSILON));
+
+      for(uint32_t c = 0; c < 3; c++)
+      {
+        Simd::store(&triNormals[c][p], Simd::select(useNormal, Simd::mul(cross[c], lengthRcp), cross[c]));
+      }
+    }
+
+    vec avgNormal = vec(0.0f);
+    for(uint32_t p = 0; p < primCount; p++)
+    {
+      avgNormal = avgNormal + vec(triNormals[0][p], triNormals[1][p], triNormals[2][p]);
+    }
+
+    setEarlyCullingBbox(geometry, i, vec(Simd::reduceMin(bboxMin[0]), Simd::reduceMin(bboxMin[1]), Simd::reduceMin(bboxMin[2])),
+                        vec(Simd::reduceMax(bboxMax[0]), Simd::reduceMax(bboxMax[1]), Simd::reduceMax(bboxMax[2])),
+                        objectBboxMin, objectBboxExtent);
+
+    int8_t coneX;
+    int8_t coneY;
+    avgNormal = quantizeConeNormal(avgNormal, coneX, coneY);
+
+    vtype coneNormal[3] = {Simd::set1(avgNormal.x), Simd::set1(avgNormal.y), Simd::set1(avgNormal.z)};
+    vtype mindot        = Simd::set1(1.0f);
+    for(uint32_t p = 0; p < primPadded; p += LANES)
+    {
+      vtype dot = Simd::add(Simd::add(Simd::mul(Simd::load(&triNormals[0][p]), coneNormal[0]),
+                                      Simd::mul(Simd::load(&triNormals[1][p]), coneNormal[1])),
+                            Simd::mul(Simd::load(&triNormals[2][p]), coneNormal[2]));
+      mindot    = Simd::min(mindot, dot);
+    }
+
+    meshlet.setCone(coneX, coneY, computeConeAngle(Simd::reduceMin(mindot)));
+  }
+
+  void setEarlyCullingBbox(MeshletGeometry& geometry, size_t i, vec bboxMin, vec bboxMax, const float objectBboxMin[3], const vec& objectBboxExtent) const
+  {
+    if(m_separateBboxes)
+    {
+      geometry.meshletBboxes[i].bboxMin[0] = bboxMin.x;
+      geometry.meshletBboxes[i].bboxMin[1] = bboxMin.y;
+      geometry.meshletBboxes[i].bboxMin[2] = bboxMin.z;
+      geometry.meshletBboxes[i].bboxMax[0] = bboxMax.x;
+      geometry.meshletBboxes[i].bboxMax[1] = bboxMax.y;
+      geometry.meshletBboxes[i].bboxMax[2] = bboxMax.z;
+    }
+
+    // truncate min relative to object min
+    bboxMin = bboxMin - vec(objectBboxMin);
+    bboxMax = bboxMax - vec(objectBboxMin);
+    bboxMin = bboxMin / objectBboxExtent;
+    bboxMax = bboxMax / objectBboxExtent;
+
+    // snap to grid
+    const int gridBits = 8;
+    const int gridLast = (1 << gridBits) - 1;
+    uint8_t   gridMin[3];
+    uint8_t   gridMax[3];
+
+    gridMin[0] = std::max(0, std::min(int(truncf(bboxMin.x * float(gridLast))), gridLast - 1));
+    gridMin[1] = std::max(0, std::min(int(truncf(bboxMin.y * float(gridLast))), gridLast - 1));
+    gridMin[2] = std::max(0, std::min(int(truncf(bboxMin.z * float(gridLast))), gridLast - 1));
+    gridMax[0] = std::max(0, std::min(int(ceilf(bboxMax.x * float(gridLast))), gridLast));
+    gridMax[1] = std::max(0, std::min(int(ceilf(bboxMax.y * float(gridLast))), gridLast));
+    gridMax[2] = std::max(0, std::min(int(ceilf(bboxMax.z * float(gridLast))), gridLast));
+
+    geometry.meshletDescriptors[i].setBBox(gridMin, gridMax);
+  }
+
+  // returns the cone normal after quantization
+  static vec quantizeConeNormal(vec avgNormal, int8_t& coneX, int8_t& coneY)
+  {
+    // potential improvement, instead of average maybe use
+    // http://www.cs.technion.ac.il/~cggc/files/gallery-pdfs/Barequet-1.pdf
+
+    float len = vec_length(avgNormal);
+    if(len > FLT_EPSILON)
+    {
+      avgNormal = avgNormal / len;
+    }
+    else
+    {
+      avgNormal = vec(0.0f);
+    }
+
+    vec packed = float32x3_to_octn_precise(avgNormal, 16);
+    coneX      = static_cast<int8_t>(std::min(127, std::max(-127, int32_t(packed.x * 127.0f))));
+    coneY      = static_cast<int8_t>(std::min(127, std::max(-127, int32_t(packed.y * 127.0f))));
+
+    // post quantization normal
+    return oct_to_float32x3(vec(float(coneX) / 127.0f, float(coneY) / 127.0f, 0.0f));
+  }
+
+  static int8_t computeConeAngle(float mindot)
+  {
+    // apply safety delta due to quantization
+    mindot -= 1.0f / 127.0f;
+    mindot = std::max(-1.0f, mindot);
+
+    // positive value for cluster not being backface cullable (normals > 90°)
+    int8_t coneAngle = 127;
+    if(mindot > 0)
+    {
+      // otherwise store -sin(cone angle)
+      // we test against dot product (cosine) so this is equivalent to cos(cone angle + 90°)
+      // round towards -1, truncating would widen the cone near 90° where sin is flat
+      float angle = -sinf(acosf(mindot));
+      coneAngle   = static_cast<int8_t>(std::max(-127, std::min(127, int32_t(floorf(angle * 127.0f)))));
+    }
+    return coneAngle;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // triangle strips per meshlet
+
+public:
+  // Reorders the primitives of each meshlet into triangle strips and stores
+  // them with PACKBASIC_PRIM_STRIPS, which takes about one index byte per
+  // primitive instead of three. The winding of the primitives is kept, their
+  // order within the meshlet is not. Must be called before
+  // buildMeshletPositions, buildMeshletParts and appendMeshletLods.
+  void buildMeshletStrips(MeshletGeometry& geometry) const
+  {
+    // the sections after the primitives would have to move
+    assert(!geometry.positionLatticeBits && !geometry.mergedParts);
+
+    std::vector<PackBasicType> meshletPacks;
+    meshletPacks.reserve(geometry.meshletPacks.size());
+
+    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    {
+      MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+      const auto*           pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+      uint32_t primCount   = meshlet.getNumPrims();
+      uint32_t primStart   = meshlet.getPrimStart();
+      uint32_t vertexCount = meshlet.getNumVertices();
+      assert(vertexCount <= MAX_VERTICES && primCount <= MAX_PRIMITIVES);
+
+      // skip unset
+      if(vertexCount == 1)
+        continue;
+
+      uint8_t primitives[MAX_PRIMITIVES][3];
+      for(uint32_t p = 0; p < primCount; p++)
+      {
+        pack->getPrimIndices(meshlet, p, primitives[p]);
+      }
+
+      uint8_t  stripIndices[MAX_PRIMITIVES * 3];
+      uint32_t restartBits[(MAX_PRIMITIVES + PACKBASIC_STRIP_RESTART_INTERVAL - 1) / PACKBASIC_STRIP_RESTART_INTERVAL] = {};
+      uint32_t numIndices = buildStrips(primitives, primCount, vertexCount, stripIndices, restartBits);
+
+      uint32_t restartWords = meshlet.getPrimStripRestartWords();
+      uint32_t oldOffset    = meshlet.getPackOffset();
+      uint32_t packedSize   = alignedSize(primStart + restartWords + (numIndices + 3) / 4, PACKBASIC_ALIGN);
+      uint32_t packOffset   = uint32_t(meshletPacks.size());
+
+      meshletPacks.resize(packOffset + packedSize, 0);
+      memcpy(&meshletPacks[packOffset], &geometry.meshletPacks[oldOffset], sizeof(PackBasicType) * primStart);
+
+      auto* newPack = (MeshletPackBasic*)&meshletPacks[packOffset];
+      memcpy(newPack->data32 + primStart, restartBits, sizeof(uint32_t) * restartWords);
+      memcpy(newPack->data8 + (primStart + restartWords) * 4, stripIndices, numIndices);
+
+      meshlet.setPackOffset(packOffset);
+      meshlet.setPrimStrips();
+    }
+
+    geometry.meshletPacks = std::move(meshletPacks);
+  }
+
+private:
+  // Greedy stripification, each strip starts with the unused primitive that
+  // has the fewest unused neighbors and is extended while a primitive shares
+  // the last edge with matching winding. Returns the number of strip indices.
+  static uint32_t buildStrips(const uint8_t primitives[][3], uint32_t primCount, uint32_t vertexCount, uint8_t* stripIndices, uint32_t* restartBits)
+  {
+    // vertex to primitive adjacency
+    uint16_t adjacencyOffsets[MAX_VERTICES + 1] = {};
+    uint8_t  adjacencyPrims[MAX_PRIMITIVES * 3];
+    for(uint32_t p = 0; p < primCount; p++)
+    {
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        adjacencyOffsets[primitives[p][k] + 1]++;
+      }
+    }
+    for(uint32_t v = 0; v < vertexCount; v++)
+    {
+      adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    {
+      uint16_t fill[MAX_VERTICES];
+      memcpy(fill, adjacencyOffsets, sizeof(uint16_t) * vertexCount);
+      for(uint32_t p = 0; p < primCount; p++)
+      {
+        for(uint32_t k = 0; k < 3; k++)
+        {
+          adjacencyPrims[fill[primitives[p][k]]++] = uint8_t(p);
+        }
+      }
+    }
+
+    uint8_t used[MAX_PRIMITIVES]      = {};
+    uint8_t neighbors[MAX_PRIMITIVES] = {};
+
+    // unused primitive other than "self" with the directed edge a -> b, its third vertex is returned in "c"
+    auto findEdge = [&](uint32_t a, uint32_t b, uint32_t self, uint32_t& c) {
+      for(uint32_t i = adjacencyOffsets[a]; i < adjacencyOffsets[a + 1]; i++)
+      {
+        uint32_t p = adjacencyPrims[i];
+        if(used[p] || p == self)
+          continue;
+        for(uint32_t k = 0; k < 3; k++)
+        {
+          if(primitives[p][k] == a && primitives[p][(k + 1) % 3] == b)
+          {
+            c = primitives[p][(k + 2) % 3];
+            return p;
+          }
+        }
+      }
+      return ~0u;
+    };
+
+    // neighbors share an edge with opposite direction
+    for(uint32_t p = 0; p < primCount; p++)
+    {
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        uint32_t c;
+        neighbors[p] += findEdge(primitives[p][(k + 1) % 3], primitives[p][k], p, c) != ~0u ? 1 : 0;
+      }
+    }
+
+    auto markUsed = [&](uint32_t p) {
+      used[p] = 1;
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        uint32_t c;
+        uint32_t n = findEdge(primitives[p][(k + 1) % 3], primitives[p][k], p, c);
+        if(n != ~0u && neighbors[n])
+        {
+          neighbors[n]--;
+        }
+      }
+    };
+
+    uint32_t numIndices = 0;
+    uint32_t prim       = 0;
+    while(prim < primCount)
+    {
+      uint32_t start = ~0u;
+      for(uint32_t p = 0; p < primCount; p++)
+      {
+        if(!used[p] && (start == ~0u || neighbors[p] < neighbors[start]))
+        {
+          start = p;
+        }
+      }
+
+      // rotate so that the strip continues over a neighbor of the last edge
+      uint32_t rotation = 0;
+      for(uint32_t r = 0; r < 3; r++)
+      {
+        uint32_t c;
+        if(findEdge(primitives[start][(r + 2) % 3], primitives[start][(r + 1) % 3], start, c) != ~0u)
+        {
+          rotation = r;
+          break;
+        }
+      }
+
+      restartBits[prim / PACKBASIC_STRIP_RESTART_INTERVAL] |= 1u << (prim % PACKBASIC_STRIP_RESTART_INTERVAL);
+      for(uint32_t k = 0; k < 3; k++)
+      {
+        stripIndices[numIndices++] = primitives[start][(rotation + k) % 3];
+      }
+      markUsed(start);
+      prim++;
+
+      // odd primitives within the strip are decoded with swapped first indices
+      for(uint32_t odd = 1; prim < primCount && (prim % PACKBASIC_STRIP_RESTART_INTERVAL) != 0; odd ^= 1)
+      {
+        uint32_t a = stripIndices[numIndices - 2];
+        uint32_t b = stripIndices[numIndices - 1];
+        uint32_t c;
+        uint32_t next = odd ? findEdge(b, a, ~0u, c) : findEdge(a, b, ~0u, c);
+        if(next == ~0u)
+          break;
+
+        stripIndices[numIndices++] = uint8_t(c);
+        markUsed(next);
+        prim++;
+      }
+    }
+
+    return numIndices;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // quantized positions per meshlet
+
+public:
+  // Positions are snapped to a lattice of (2^latticeBits - 1) steps across the
+  // object bbox. Every meshlet stores its lattice minimum followed by per-vertex
+  // offsets using the fewest bits that cover its bbox on the lattice.
+  // As all meshlets share the lattice, vertices on meshlet borders decode
+  // to identical positions and no cracks appear.
+  // The packs are re-laid out to append the positions after the primitives.
+  void buildMeshletPositions(MeshletGeometry&         geometry,
+                             const float              objectBboxMin[3],
+                             const float              objectBboxMax[3],
+                             const float* NV_RESTRICT positions,
+                             const size_t             positionStride,
+                             uint32_t                 latticeBits) const
+  {
+    assert((positionStride % sizeof(float)) == 0);
+    assert(latticeBits > 0 && latticeBits <= 16);
+    // part ranges must be added last
+    assert(!geometry.mergedParts);
+
+    size_t positionMul = positionStride / sizeof(float);
+
+    float latticeLast = float((1 << latticeBits) - 1);
+    float latticeScale[3];
+    for(uint32_t c = 0; c < 3; c++)
+    {
+      float extent    = objectBboxMax[c] - objectBboxMin[c];
+      latticeScale[c] = extent > 0 ? latticeLast / extent : 0.0f;
+    }
+
+    std::vector<PackBasicType> meshletPacks;
+    meshletPacks.reserve(geometry.meshletPacks.size() + geometry.meshletPacks.size() / 2);
+
+    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    {
+      MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+      const auto*           pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+      uint32_t vertexCount   = meshlet.getNumVertices();
+      uint32_t vertexPack    = meshlet.getNumVertexPack();
+      uint32_t positionStart = pack->getPositionStart(meshlet);
+      assert(vertexCount <= MAX_VERTICES);
+
+      uint32_t lattice[MAX_VERTICES][3];
+      uint32_t latticeMin[3] = {~0u, ~0u, ~0u};
+      uint32_t latticeMax[3] = {0, 0, 0};
+
+      for(uint32_t v = 0; v < vertexCount; v++)
+      {
+        uint32_t     idx = pack->getVertexIndex(v, vertexPack);
+        const float* pos = &positions[idx * positionMul];
+
+        for(uint32_t c = 0; c < 3; c++)
+        {
+          float value   = std::max(0.0f, std::min(latticeLast, (pos[c] - objectBboxMin[c]) * latticeScale[c]));
+          lattice[v][c] = uint32_t(value + 0.5f);
+          latticeMin[c] = std::min(latticeMin[c], lattice[v][c]);
+          latticeMax[c] = std::max(latticeMax[c], lattice[v][c]);
+        }
+      }
+
+      uint32_t bits = 1;
+      for(uint32_t c = 0; c < 3; c++)
+      {
+        while(bits < latticeBits && ((latticeMax[c] - latticeMin[c]) >> bits))
+        {
+          bits++;
+        }
+      }
+
+      uint32_t oldOffset  = meshlet.getPackOffset();
+      uint32_t packedSize = alignedSize(positionStart + 2 + (vertexCount * 3 * bits + 31) / 32, PACKBASIC_ALIGN);
+      uint32_t packOffset = uint32_t(meshletPacks.size());
+
+      meshletPacks.resize(packOffset + packedSize, 0);
+      memcpy(&meshletPacks[packOffset], &geometry.meshletPacks[oldOffset], sizeof(PackBasicType) * positionStart);
+
+      auto* newPack = (MeshletPackBasic*)&meshletPacks[packOffset];
+      newPack->setPositionHeader(positionStart, latticeMin, bits);
+      for(uint32_t v = 0; v < vertexCount; v++)
+      {
+        const uint32_t relative[3] = {lattice[v][0] - latticeMin[0], lattice[v][1] - latticeMin[1], lattice[v][2] - latticeMin[2]};
+        newPack->setPosition(packedSize, v, positionStart, bits, relative);
+      }
+
+      meshlet.setPackOffset(packOffset);
+    }
+
+    geometry.meshletPacks        = std::move(meshletPacks);
+    geometry.positionLatticeBits = latticeBits;
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Appends the part ranges to the packs of meshlets that were built with
+  // buildMeshlets over the indices of several consecutive parts.
+  // triangleParts provides the part of each input triangle, parts must not
+  // decrease. Must be called after all other build functions, shaders
+  // discard primitives of parts that are not drawn.
+
+  template <class VertexIndexType>
+  void buildMeshletParts(MeshletGeometry&                   geometry,
+                         const uint32_t                     numIndices,
+                         const VertexIndexType* NV_RESTRICT indices,
+                         const uint32_t* NV_RESTRICT        triangleParts) const
+  {
+    std::vector<PackBasicType> meshletPacks;
+    meshletPacks.reserve(geometry.meshletPacks.size() + geometry.meshletDescriptors.size() * PACKBASIC_ALIGN);
+
+    // buildMeshlets consumes the triangles in order, skipping degenerate ones
+    uint32_t triangle         = 0;
+    auto     nextTrianglePart = [&]() {
+      for(; triangle < numIndices / 3; triangle++)
+      {
+        const VertexIndexType* tri = indices + triangle * 3;
+        if(tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
+        {
+          return triangleParts[triangle++];
+        }
+      }
+      assert(0 && "meshlets do not match indices");
+      return 0u;
+    };
+
+    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    {
+      MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+
+      uint32_t primCount = meshlet.getNumPrims();
+      uint32_t partStart = getPartStart(geometry, meshlet);
+
+      uint32_t primParts[MAX_PRIMITIVES];
+      uint32_t numRanges = 0;
+      for(uint32_t p = 0; p < primCount; p++)
+      {
+        primParts[p] = nextTrianglePart();
+        assert(primParts[p] >= primParts[0]);
+        numRanges += (p && primParts[p] != primParts[p - 1]) ? 1 : 0;
+      }
+
+      uint32_t oldOffset  = meshlet.getPackOffset();
+      uint32_t packedSize = alignedSize(partStart + 1 + numRanges, PACKBASIC_ALIGN);
+      uint32_t packOffset = uint32_t(meshletPacks.size());
+
+      meshletPacks.resize(packOffset + packedSize, 0);
+      memcpy(&meshletPacks[packOffset], &geometry.meshletPacks[oldOffset], sizeof(PackBasicType) * partStart);
+
+      auto* newPack = (MeshletPackBasic*)&meshletPacks[packOffset];
+      newPack->setPartHeader(partStart, primParts[0], numRanges);
+      for(uint32_t p = 1, r = 0; p < primCount; p++)
+      {
+        if(primParts[p] != primParts[p - 1])
+        {
+          newPack->setPartRange(partStart, r++, primParts[p] - primParts[0], p);
+        }
+      }
+
+      meshlet.setPackOffset(packOffset);
+    }
+
+    geometry.meshletPacks = std::move(meshletPacks);
+    geometry.mergedParts  = true;
+  }
+
+  // first and last part of a meshlet's primitives, requires buildMeshletParts
+  static void getMeshletParts(const MeshletGeometry& geometry, size_t meshletIndex, uint32_t& partFirst, uint32_t& partLast)
+  {
+    const MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[meshletIndex];
+    const auto* pack      = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+    uint32_t    partStart = getPartStart(geometry, meshlet);
+
+    assert(geometry.mergedParts);
+
+    partFirst = pack->getPrimPart(0, partStart);
+    partLast  = pack->getPrimPart(meshlet.getNumPrims() - 1, partStart);
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Appends one MeshletLod per meshlet to the packs, see nvmeshlet_lod.hpp.
+  // Must be called after all other build functions, cannot be combined with
+  // buildMeshletParts. The result may be appended to geometries without lods,
+  // the records are only read when drawing the lod hierarchy.
+
+  void appendMeshletLods(MeshletGeometry& geometry, const MeshletLod* NV_RESTRICT lods) const
+  {
+    assert(!geometry.mergedParts);
+
+    std::vector<PackBasicType> meshletPacks;
+    meshletPacks.reserve(geometry.meshletPacks.size() + geometry.meshletDescriptors.size() * PACKBASIC_ALIGN);
+
+    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    {
+      MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+
+      uint32_t lodStart   = getPartStart(geometry, meshlet);
+      uint32_t oldOffset  = meshlet.getPackOffset();
+      uint32_t packedSize = alignedSize(lodStart + PACKBASIC_LOD_SIZE, PACKBASIC_ALIGN);
+      uint32_t packOffset = uint32_t(meshletPacks.size());
+
+      meshletPacks.resize(packOffset + packedSize, 0);
+      memcpy(&meshletPacks[packOffset], &geometry.meshletPacks[oldOffset], sizeof(PackBasicType) * lodStart);
+
+      auto* newPack = (MeshletPackBasic*)&meshletPacks[packOffset];
+      newPack->setLod(lodStart, lods[i]);
+
+      meshlet.setPackOffset(packOffset);
+    }
+
+    geometry.meshletPacks = std::move(meshletPacks);
+  }
+
+  // requires appendMeshletLods
+  static void getMeshletLod(const MeshletGeometry& geometry, size_t meshletIndex, MeshletLod& lod)
+  {
+    const MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[meshletIndex];
+    const auto* pack = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+    pack->getLod(getPartStart(geometry, meshlet), lod);
+  }
+
+  // the part ranges or lods follow the primitives and the optional positions
+  static uint32_t getExtraStart(const MeshletPackBasicDesc& meshlet, const MeshletPackBasic* pack, bool hasPositions)
+  {
+    uint32_t positionStart = pack->getPositionStart(meshlet);
+    if(!hasPositions)
+    {
+      return positionStart;
+    }
+
+    uint32_t latticeMin[3];
+    uint32_t bits;
+    pack->getPositionHeader(positionStart, latticeMin, bits);
+
+    return positionStart + 2 + (meshlet.getNumVertices() * 3 * bits + 31) / 32;
+  }
+
+private:
+  static uint32_t getPartStart(const MeshletGeometry& geometry, const MeshletPackBasicDesc& meshlet)
+  {
+    const auto* pack = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+    return getExtraStart(meshlet, pack, geometry.positionLatticeBits != 0);
+  }
+
+public:
+
+  //////////////////////////////////////////////////////////////////////////
+
+  template <class VertexIndexType>
+  StatusCode errorCheck(const MeshletGeometry&             geometry,
+                        uint32_t                           minVertex,
+                        uint32_t                           maxVertex,
+                        uint32_t                           numIndices,
+                        const VertexIndexType* NV_RESTRICT indices) const
+  {
+    uint32_t compareTris = 0;
+
+    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    {
+      const MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+      const MeshletPackBasic*     pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+      uint32_t primCount   = meshlet.getNumPrims();
+      uint32_t vertexCount = meshlet.getNumVertices();
+      uint32_t vertexPack  = meshlet.getNumVertexPack();
+
+      // skip unset
+      if(vertexCount == 1)
+        continue;
+
+      for(uint32_t p = 0; p < primCount; p++)
+      {
+        uint8_t blockIndices[3];
+        pack->getPrimIndices(meshlet, p, blockIndices);
+
+        if(blockIndices[0] >= m_maxVertexCount || blockIndices[1] >= m_maxVertexCount || blockIndices[2] >= m_maxVertexCount)
+        {
+          return STATUS_PRIM_OUT_OF_BOUNDS;
+        }
+
+        uint32_t idxA = pack->getVertexIndex(blockIndices[0], vertexPack);
+        uint32_t idxB = pack->getVertexIndex(blockIndices[1], vertexPack);
+        uint32_t idxC = pack->getVertexIndex(blockIndices[2], vertexPack);
+
+        if(idxA < minVertex || idxA > maxVertex || idxB < minVertex || idxB > maxVertex || idxC < minVertex || idxC > maxVertex)
+        {
+          return STATUS_VERTEX_OUT_OF_BOUNDS;
         }
 
         uint32_t refA = 0;
@@ -630,6 +1755,83 @@ public:
     return STATUS_NO_ERROR;
   }
 
+  // Like errorCheck, but the triangles may be stored in any order across
+  // the meshlets, as done by buildMeshletsSpatial, and may start with any
+  // of their vertices, as done by buildMeshletStrips. The winding must match.
+  template <class VertexIndexType>
+  StatusCode errorCheckUnordered(const MeshletGeometry&             geometry,
+                                 uint32_t                           minVertex,
+                                 uint32_t                           maxVertex,
+                                 uint32_t                           numIndices,
+                                 const VertexIndexType* NV_RESTRICT indices) const
+  {
+    typedef std::tuple<uint32_t, uint32_t, uint32_t> Triangle;
+
+    // rotated to start with the smallest index
+    auto makeTriangle = [](uint32_t a, uint32_t b, uint32_t c) {
+      if(b < a && b < c)
+        return Triangle(b, c, a);
+      if(c < a && c < b)
+        return Triangle(c, a, b);
+      return Triangle(a, b, c);
+    };
+
+    std::vector<Triangle> trianglesMeshlet;
+    std::vector<Triangle> trianglesRef;
+
+    for(size_t i = 0; i < geometry.meshletDescriptors.size(); i++)
+    {
+      const MeshletPackBasicDesc& meshlet = geometry.meshletDescriptors[i];
+      const MeshletPackBasic*     pack    = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+      uint32_t primCount   = meshlet.getNumPrims();
+      uint32_t vertexCount = meshlet.getNumVertices();
+      uint32_t vertexPack  = meshlet.getNumVertexPack();
+
+      // skip unset
+      if(vertexCount == 1)
+        continue;
+
+      for(uint32_t p = 0; p < primCount; p++)
+      {
+        uint8_t blockIndices[3];
+        pack->getPrimIndices(meshlet, p, blockIndices);
+
+        if(blockIndices[0] >= m_maxVertexCount || blockIndices[1] >= m_maxVertexCount || blockIndices[2] >= m_maxVertexCount)
+        {
+          return STATUS_PRIM_OUT_OF_BOUNDS;
+        }
+
+        uint32_t idxA = pack->getVertexIndex(blockIndices[0], vertexPack);
+        uint32_t idxB = pack->getVertexIndex(blockIndices[1], vertexPack);
+        uint32_t idxC = pack->getVertexIndex(blockIndices[2], vertexPack);
+
+        if(idxA < minVertex || idxA > maxVertex || idxB < minVertex || idxB > maxVertex || idxC < minVertex || idxC > maxVertex)
+        {
+          return STATUS_VERTEX_OUT_OF_BOUNDS;
+        }
+
+        trianglesMeshlet.push_back(makeTriangle(idxA, idxB, idxC));
+      }
+    }
+
+    for(uint32_t t = 0; t < numIndices / 3; t++)
+    {
+      uint32_t refA = indices[t * 3 + 0];
+      uint32_t refB = indices[t * 3 + 1];
+      uint32_t refC = indices[t * 3 + 2];
+      if(refA == refB || refA == refC || refB == refC)
+        continue;
+
+      trianglesRef.push_back(makeTriangle(refA, refB, refC));
+    }
+
+    std::sort(trianglesMeshlet.begin(), trianglesMeshlet.end());
+    std::sort(trianglesRef.begin(), trianglesRef.end());
+
+    return trianglesMeshlet == trianglesRef ? STATUS_NO_ERROR : STATUS_MISMATCH_INDICES;
+  }
+
   void appendStats(const MeshletGeometry& geometry, Stats& stats) const
   {
     if(geometry.meshletDescriptors.empty())
@@ -639,6 +1841,26 @@ public:
 
     stats.meshletsStored += geometry.meshletDescriptors.size();
 
+    if(geometry.positionLatticeBits)
+    {
+      for(const auto& meshlet : geometry.meshletDescriptors)
+      {
+        // skip padding
+        if(meshlet.getNumVertices() == 1)
+        {
+          continue;
+        }
+
+        const auto* pack = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+
+        uint32_t latticeMin[3];
+        uint32_t bits;
+        pack->getPositionHeader(pack->getPositionStart(meshlet), latticeMin, bits);
+
+        stats.posBitTotal += 64 + meshlet.getNumVertices() * 3 * bits;
+      }
+    }
+
     double primloadAvg   = 0;
     double primloadVar   = 0;
     double vertexloadAvg = 0;
@@ -659,6 +1881,20 @@ public:
 
       stats.vertexTotal += vertexCount;
       stats.primTotal += primCount;
+
+      // index slots in the pack, including alignment
+      uint32_t vertexPack = meshlet.getNumVertexPack();
+      if(vertexPack & PACKBASIC_VERTEX_DELTA)
+      {
+        stats.vertexIndices += (meshlet.getVertexSize() - 1) * 32 / (vertexPack & ~PACKBASIC_VERTEX_DELTA);
+      }
+      else
+      {
+        stats.vertexIndices += meshlet.getVertexSize() * vertexPack;
+      }
+      const auto* pack = (const MeshletPackBasic*)&geometry.meshletPacks[meshlet.getPackOffset()];
+      stats.primIndices += pack->getPrimSize(meshlet) * 4;
+
       primloadAvg += double(primCount) / double(m_maxPrimitiveCount);
       vertexloadAvg += double(vertexCount) / double(m_maxVertexCount);
 
@@ -681,6 +1917,11 @@ public:
       uint32_t vertexCount = meshlet.getNumVertices();
       double   diff;
 
+      if(vertexCount == 1)
+      {
+        continue;
+      }
+
       diff = primloadAvg - ((double(primCount) / double(m_maxPrimitiveCount)));
       primloadVar += diff * diff;
 
@@ -696,7 +1937,97 @@ public:
     stats.vertexloadVar += vertexloadVar;
     stats.appended += 1.0;
   }
+
+  void appendHistograms(const MeshletGeometry& geometry, StatsHistograms& histograms) const
+  {
+    for(auto meshlet : geometry.meshletDescriptors)
+    {
+      uint32_t vertexCount = meshlet.getNumVertices();
+
+      // skip padding
+      if(vertexCount == 1)
+      {
+        continue;
+      }
+
+      histograms.vertices[vertexCount]++;
+      histograms.primitives[meshlet.getNumPrims()]++;
+
+      int8_t coneX;
+      int8_t coneY;
+      int8_t coneAngle;
+      meshlet.getCone(coneX, coneY, coneAngle);
+      histograms.cones[int32_t(coneAngle) + 128]++;
+
+      uint8_t bboxMin[3];
+      uint8_t bboxMax[3];
+      meshlet.getBBox(bboxMin, bboxMax);
+      uint32_t extent = 0;
+      for(uint32_t i = 0; i < 3; i++)
+      {
+        extent = std::max(extent, uint32_t(bboxMax[i]) - uint32_t(std::min(bboxMin[i], bboxMax[i])));
+      }
+      histograms.bboxExtents[extent]++;
+    }
+  }
 };
+
+typedef PackBasicBuilderT<> PackBasicBuilder;
+
+// Calls func with a default constructed PackBasicBuilderT whose compile-time
+// limits match the given ones (32/64/96/128 vertices x 40/64/84/126 primitives),
+// other combinations use the generic PackBasicBuilder.
+// The builder still needs to be setup with the runtime limits.
+template <class Func>
+void dispatchPackBasicBuilder(uint32_t maxVertexCount, uint32_t maxPrimitiveCount, Func&& func)
+{
+#define NVMESHLET_DISPATCH_PRIMITIVES(VERTICES)                                                                        \
+  switch(maxPrimitiveCount)                                                                                            \
+  {                                                                                                                    \
+    case 40: {                                                                                                         \
+      PackBasicBuilderT<VERTICES, 40> builder{};                                                                       \
+      func(builder);                                                                                                   \
+      return;                                                                                                          \
+    }                                                                                                                  \
+    case 64: {                                                                                                         \
+      PackBasicBuilderT<VERTICES, 64> builder{};                                                                       \
+      func(builder);                                                                                                   \
+      return;                                                                                                          \
+    }                                                                                                                  \
+    case 84: {                                                                                                         \
+      PackBasicBuilderT<VERTICES, 84> builder{};                                                                       \
+      func(builder);                                                                                                   \
+      return;                                                                                                          \
+    }                                                                                                                  \
+    case 126: {                                                                                                        \
+      PackBasicBuilderT<VERTICES, 126> builder{};                                                                      \
+      func(builder);                                                                                                   \
+      return;                                                                                                          \
+    }                                                                                                                  \
+  }
+
+  switch(maxVertexCount)
+  {
+    case 32:
+      NVMESHLET_DISPATCH_PRIMITIVES(32)
+      break;
+    case 64:
+      NVMESHLET_DISPATCH_PRIMITIVES(64)
+      break;
+    case 96:
+      NVMESHLET_DISPATCH_PRIMITIVES(96)
+      break;
+    case 128:
+      NVMESHLET_DISPATCH_PRIMITIVES(128)
+      break;
+  }
+
+#undef NVMESHLET_DISPATCH_PRIMITIVES
+
+  PackBasicBuilder builder{};
+  func(builder);
+}
+
 }  // namespace NVMeshlet
 
 #endif
@@ -42,6 +42,9 @@
 #define USE_EARLY_CLIPPINGCULL 1
 #endif
 
+// world-space positions are worldMatrix * oPos + copyOffset,
+// the includer declares copyBuffer next to objectBuffer
+
 #if NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKBASIC
   /*
   Pack
@@ -61,7 +64,7 @@
       signed  coneOctX : 8;
       signed  coneOctY : 8;
       signed  coneAngle : 8;
-    unsigned  vertexBits : 8;
+    unsigned  vertexBits : 8;   // vertex indices per 32 bits | 0x40 for strips
     
     // w
     unsigned  packOffset : 32;
@@ -79,17 +82,169 @@ void decodeMeshlet( uvec4 meshletDesc,
   primMax    = (meshletDesc.y >> 24);
   
   vidxStart  =  packOffset;
-  vidxDiv    = (meshletDesc.z >> 24);
+  vidxDiv    = (meshletDesc.z >> 24) & 0x3F;
   vidxBits   = vidxDiv == 2 ? 16 : 0;
   
   primDiv    = 4;
   primStart  =  (packOffset + ((vMax + 1 + vidxDiv - 1) / vidxDiv) + 1) & ~1;
 }
 
+#elif NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKDELTA
+  /*
+    same descriptor as PACKBASIC, except
+    
+    // z
+    unsigned  vertexBits : 8;   // 0x80 | delta bits | 0x40 for strips
+    
+    vertex indices are stored as
+    { u32 base, bits[(vertexMax + 1) * deltaBits ...] }
+  */
+
+void decodeMeshlet( uvec4 meshletDesc, 
+                    out uint vertMax, out uint primMax,
+                    out uint primStart, out uint primDiv,
+                    out uint vidxStart, out uint vidxBits, out uint vidxDiv)
+{
+  uint vMax  = (meshletDesc.x >> 24);
+  uint packOffset = meshletDesc.w;
+  
+  vertMax    = vMax;
+  primMax    = (meshletDesc.y >> 24);
+  
+  vidxStart  =  packOffset;
+  vidxDiv    = 1;
+  vidxBits   = (meshletDesc.z >> 24) & 0x3F;
+  
+  primDiv    = 4;
+  primStart  =  (packOffset + 1 + (((vMax + 1) * vidxBits + 31) / 32) + 1) & ~1;
+}
+
 #else
   #error "NVMESHLET_ENCODING not supported"
 #endif
 
+// returns the "bits" wide value which starts at bit "shift" within
+// "lo" and may continue into "hi"
+uint decodeBits(uint lo, uint hi, uint shift, uint bits)
+{
+  uint value = lo >> shift;
+  if (shift != 0) {
+    value |= hi << (32 - shift);
+  }
+  return bits == 32 ? value : (value & ((1u << bits) - 1));
+}
+
+#if NVMESHLET_PRIMITIVE_STRIPS
+  /*
+    primitives are stored as triangle strips, see PackBasicBuilder::buildMeshletStrips
+    
+    { u32 restartBits[(primMax + 32) / 32], u8[primMax + 1 + 2 * numStrips ...] }
+    
+    a primitive's last index is at prim + 2 * (restarts up to and including prim),
+    odd primitives within a strip swap their first two indices. Strips restart
+    every 32 primitives, so a strip's first primitive is within the same restart word.
+  */
+
+uint getMeshletStripRestartWords(uint primMax)
+{
+  return (primMax + 32) / 32;
+}
+
+// x: byte offset of the primitive's last index within the strip indices
+// y: 1 if the first two indices are swapped
+// restartWord holds the restart bits of the primitive, restartsBefore the restarts of all prior words
+uvec2 decodeStripPrimitive(uint prim, uint restartWord, uint restartsBefore)
+{
+  uint bit  = prim & 31;
+  uint bits = restartWord & (0xFFFFFFFFu >> (31 - bit));
+  uint restarts = restartsBefore + bitCount(bits);
+  return uvec2(prim + restarts * 2, (bit - uint(findMSB(bits))) & 1);
+}
+#endif
+
+// size of the primitive indices in 32-bit words, numStrips is ignored without strips
+uint getMeshletPrimSize(uint primMax, uint numStrips)
+{
+#if NVMESHLET_PRIMITIVE_STRIPS
+  return getMeshletStripRestartWords(primMax) + (primMax + 1 + numStrips * 2 + 3) / 4;
+#else
+  // primitive indices are padded to PACKBASIC_PRIMITIVE_INDICES_PER_FETCH (8)
+  return ((primMax + 1) * 3 + 8 - 1) / 4;
+#endif
+}
+
+#if NVMESHLET_POSITION_BITS
+  /*
+    quantized positions follow the primitive indices, 
+    see PackBasicBuilder::buildMeshletPositions
+    
+    { u32 minX | minY << 16, u32 minZ | bits << 16, bits[(vertexMax + 1) * 3 * bits ...] }
+    
+    all meshlets of an object share the same lattice across the
+    object's bbox, so vertices along meshlet borders match exactly
+  */
+
+uint getMeshletPositionStart(uint primStart, uint primSize)
+{
+  return primStart + primSize;
+}
+
+// xyz: lattice minimum of the meshlet, w: bits per component
+uvec4 decodeMeshletPositionHeader(uint word0, uint word1)
+{
+  return uvec4(word0 & 0xFFFF, word0 >> 16, word1 & 0xFFFF, word1 >> 16);
+}
+
+vec3 dequantizePosition(uvec3 lattice, in ObjectData object)
+{
+  const float latticeLast = float((1 << NVMESHLET_POSITION_BITS) - 1);
+  return object.bboxMin.xyz + vec3(lattice) * ((object.bboxMax.xyz - object.bboxMin.xyz) / latticeLast);
+}
+#endif
+
+#if NVMESHLET_MERGED_PARTS || NVMESHLET_LOD
+  /*
+    meshlets span consecutive parts, the part ranges follow the
+    primitive indices and the optional positions,
+    see PackBasicBuilder::buildMeshletParts
+    
+    { u32 basePart | numRanges << 24, u32[numRanges] partDelta | primBegin << 24 }
+
+    meshlets of lod hierarchies store their lod at the same location
+  */
+
+uint getMeshletPartStart(uint primStart, uint primSize, uint vertMax, uint positionBits)
+{
+  uint start = primStart + primSize;
+  // position header and bits
+  return positionBits != 0 ? start + 2 + ((vertMax + 1) * 3 * positionBits + 31) / 32 : start;
+}
+#endif
+
+#if NVMESHLET_LOD
+  /*
+    bounds (center, radius) and error of the group that created the meshlet
+    and of the group that replaces it, see nvmeshlet_lod.hpp
+    
+    { f32 bounds[4], f32 parentBounds[4], f32 error, f32 parentError }
+  */
+
+// same as NVMeshlet::isLodErrorAcceptable, bounds and error are in object space
+bool isLodErrorAcceptable(vec4 bounds, float error, in ObjectData object)
+{
+  // errors scale with the largest axis of the object
+  float scale    = max(max(length(object.worldMatrix[0].xyz), length(object.worldMatrix[1].xyz)), length(object.worldMatrix[2].xyz));
+  vec3  wCenter  = (object.worldMatrix * vec4(bounds.xyz, 1)).xyz + copyOffset.xyz;
+  float distance = max(length(wCenter - scene.viewPos.xyz) - bounds.w * scale, 0.0);
+  return error * scale * scene.lodErrorScale <= distance;
+}
+
+bool isMeshletLodSelected(vec4 bounds, vec4 parentBounds, float error, float parentError, in ObjectData object)
+{
+  return isLodErrorAcceptable(bounds, error, object) && !isLodErrorAcceptable(parentBounds, parentError, object);
+}
+#endif
+
 bool isMeshletValid(uvec4 meshletDesc)
 {
   return meshletDesc.x != 0;
@@ -127,7 +282,7 @@ vec3 oct_to_vec3(vec2 e) {
 
 void decodeNormalAngle(uvec4 meshletDesc, in ObjectData object, out vec3 oNormal, out float oAngle)
 {
-#if NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKBASIC
+#if NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKBASIC || NVMESHLET_ENCODING == NVMESHLET_ENCODING_PACKDELTA
   uint packedVec =  meshletDesc.z;
 #else
   #error "NVMESHLET_ENCODING not supported"
@@ -201,7 +356,7 @@ bool earlyCull(uvec4 meshletDesc, in ObjectData object)
   vec3 clipMax = vec3(-100000);
   
   for (int n = 0; n < 8; n++){
-    vec4 wPos = object.worldMatrix * getBoxCorner(bboxMin, bboxMax, n);
+    vec4 wPos = object.worldMatrix * getBoxCorner(bboxMin, bboxMax, n) + vec4(copyOffset.xyz, 0);
     vec4 hPos = scene.viewProjMatrix * wPos;
     frustumBits &= getCullBits(hPos);
     
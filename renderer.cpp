@@ -38,7 +38,8 @@ static void AddItem(std::vector<RenderList::DrawItem>& drawItems, const RenderLi
   {
     passes = !passes;
   }
-  di.task = config.taskMinMeshlets > 0 && di.meshlet.count >= config.taskMinMeshlets;
+  // the lod cut is selected by the task shaders
+  di.task = config.meshletLod || (config.taskMinMeshlets > 0 && di.meshlet.count >= config.taskMinMeshlets);
   if(di.range.count && passes)
   {
     drawItems.push_back(di);
@@ -49,7 +50,8 @@ static void FillSingle(std::vector<RenderList::DrawItem>& drawItems,
                        const RenderList::Config&          config,
                        const CadScene::Object&            obj,
                        const CadScene::Geometry&          geo,
-                       int                                objectIndex)
+                       int                                objectIndex,
+                       int                                copyIndex)
 {
   (void)objectIndex;
   if(!obj.parts[0].active || !geo.numIndexSolid)
@@ -59,10 +61,19 @@ static void FillSingle(std::vector<RenderList::DrawItem>& drawItems,
   di.shorts         = geo.useShorts != 0;
   di.geometryIndex  = obj.geometryIndex;
   di.matrixIndex    = obj.matrixIndex;
+  di.copyIndex      = copyIndex;
   di.range.offset   = 0;
   di.range.count    = geo.numIndexSolid;
   di.meshlet.offset = 0;
   di.meshlet.count  = geo.meshlet.numMeshlets;
+  if(config.meshletLod)
+  {
+    // the lod hierarchies of all parts follow the regular meshlets
+    di.meshlet.offset = geo.parts[0].meshLod.offset;
+    di.meshlet.count  = geo.meshlet.numMeshlets - di.meshlet.offset;
+  }
+  di.partFirst      = 0;
+  di.partLast       = uint32_t(geo.parts.size()) - 1;
 
   AddItem(drawItems, config, di);
 }
@@ -71,7 +82,8 @@ static void FillIndividual(std::vector<RenderList::DrawItem>& drawItems,
                            const RenderList::Config&          config,
                            const CadScene::Object&            obj,
                            const CadScene::Geometry&          geo,
-                           int                                objectIndex)
+                           int                                objectIndex,
+                           int                                copyIndex)
 {
   (void)objectIndex;
   for(size_t p = 0; p < obj.parts.size(); p++)
@@ -86,19 +98,80 @@ static void FillIndividual(std::vector<RenderList::DrawItem>& drawItems,
     di.shorts        = geo.useShorts != 0;
     di.geometryIndex = obj.geometryIndex;
     di.matrixIndex   = part.matrixIndex;
+    di.copyIndex     = copyIndex;
 
-    di.range   = partgeo.indexSolid;
-    di.meshlet = partgeo.meshSolid;
+    di.range     = partgeo.indexSolid;
+    di.meshlet   = config.meshletLod ? partgeo.meshLod : partgeo.meshSolid;
+    di.partFirst = uint32_t(p);
+    di.partLast  = uint32_t(p);
 
     AddItem(drawItems, config, di);
   }
 }
 
+static void FillJoin(std::vector<RenderList::DrawItem>& drawItems,
+                     const RenderList::Config&          config,
+                     const CadScene::Object&            obj,
+                     const CadScene::Geometry&          geo,
+                     int                                objectIndex,
+                     int                                copyIndex)
+{
+  (void)objectIndex;
+
+  // parts are stored consecutively in the index and meshlet buffers, a run of
+  // active parts using the same matrix is drawn as one item, which avoids
+  // partially filled task workgroups at each part's end.
+  // With task padding the meshlet range may contain invalid descriptors
+  // between parts, which the shaders skip.
+  RenderList::DrawItem di;
+  di.matrixIndex = -1;
+
+  for(size_t p = 0; p < obj.parts.size(); p++)
+  {
+    const CadScene::ObjectPart&   part        = obj.parts[p];
+    const CadScene::GeometryPart& partgeo     = geo.parts[p];
+    const CadScene::MeshletRange& partMeshlet = config.meshletLod ? partgeo.meshLod : partgeo.meshSolid;
+
+    if(part.active && di.matrixIndex == part.matrixIndex)
+    {
+      di.range.count += partgeo.indexSolid.count;
+      di.meshlet.count = partMeshlet.offset + partMeshlet.count - di.meshlet.offset;
+      di.partLast      = uint32_t(p);
+      continue;
+    }
+
+    if(di.matrixIndex >= 0)
+    {
+      AddItem(drawItems, config, di);
+      di.matrixIndex = -1;
+    }
+
+    if(!part.active)
+      continue;
+
+    di.shorts        = geo.useShorts != 0;
+    di.geometryIndex = obj.geometryIndex;
+    di.matrixIndex   = part.matrixIndex;
+    di.copyIndex     = copyIndex;
+
+    di.range     = partgeo.indexSolid;
+    di.meshlet   = partMeshlet;
+    di.partFirst = uint32_t(p);
+    di.partLast  = uint32_t(p);
+  }
+
+  if(di.matrixIndex >= 0)
+  {
+    AddItem(drawItems, config, di);
+  }
+}
+
 static inline bool DrawItem_compare_groups(const RenderList::DrawItem& a, const RenderList::DrawItem& b)
 {
   int diff;
   diff = ((a.task ? 1 : 0) - (b.task ? 1 : 0));
   diff = diff != 0 ? diff : (a.geometryIndex - b.geometryIndex);
+  diff = diff != 0 ? diff : (a.copyIndex - b.copyIndex);
   diff = diff != 0 ? diff : (a.matrixIndex - b.matrixIndex);
 
   return diff < 0;
@@ -110,22 +183,29 @@ void RenderList::setup(const CadScene* NV_RESTRICT scene, const Config& config)
   m_config = config;
   m_drawItems.clear();
 
-  size_t maxObjects = scene->m_objects.size();
+  // objects are enumerated over all scene copies, see CadScene::m_copyOffsets
+  size_t numObjects = scene->m_objects.size();
+  size_t maxObjects = scene->getNumInstancedObjects();
   size_t from       = std::min(maxObjects - 1, size_t(config.objectFrom));
   maxObjects        = std::min(maxObjects, from + size_t(config.objectNum));
 
   for(size_t i = from; i < maxObjects; i++)
   {
-    const CadScene::Object&   obj = scene->m_objects[i];
-    const CadScene::Geometry& geo = scene->m_geometry[obj.geometryIndex];
+    int                       copy = int(i / numObjects);
+    const CadScene::Object&   obj  = scene->m_objects[i % numObjects];
+    const CadScene::Geometry& geo  = scene->m_geometry[obj.geometryIndex];
 
     if(config.strategy == STRATEGY_SINGLE)
     {
-      FillSingle(m_drawItems, config, obj, geo, int(i));
+      FillSingle(m_drawItems, config, obj, geo, int(i), copy);
     }
     else if(config.strategy == STRATEGY_INDIVIDUAL)
     {
-      FillIndividual(m_drawItems, config, obj, geo, int(i));
+      FillIndividual(m_drawItems, config, obj, geo, int(i), copy);
+    }
+    else if(config.strategy == STRATEGY_JOIN)
+    {
+      FillJoin(m_drawItems, config, obj, geo, int(i), copy);
     }
   }
 
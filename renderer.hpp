@@ -34,6 +34,7 @@ public:
   {                   
     STRATEGY_SINGLE,     // entire geometry
     STRATEGY_INDIVIDUAL, // per-object
+    STRATEGY_JOIN,       // consecutive parts with same matrix
   };
 
   struct Config
@@ -45,6 +46,8 @@ public:
     uint32_t taskMinMeshlets;
     uint32_t taskNumMeshlets = 32;
     uint32_t meshNumMeshlets = 1;
+    // draw the meshlet lod hierarchies (CadScene::GeometryPart::meshLod)
+    bool meshletLod = false;
   };
 
   struct DrawItem
@@ -53,9 +56,14 @@ public:
     bool                   shorts;
     int                    geometryIndex;
     int                    matrixIndex;
+    // scene copy, selects CadScene::m_copyOffsets
+    int                    copyIndex;
     int                    cullIndex;
     CadScene::DrawRange    range;
     CadScene::MeshletRange meshlet;
+    // parts drawn, meshlets of merged parts may contain other parts as well
+    uint32_t partFirst;
+    uint32_t partLast;
   };
 
   void setup(const CadScene* NV_RESTRICT scene, const Config& config);
@@ -146,6 +146,7 @@ void RendererGL::draw(const FrameConfig& global)
 
     glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_SCENE_VIEW, 0, 0);
     glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_OBJECT, 0, 0);
+    glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_COPY, 0, 0);
     glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_GEOMETRY, 0, 0);
   }
 
@@ -162,6 +163,7 @@ void RendererGL::draw(const FrameConfig& global)
     int lastMaterial = -1;
     int lastGeometry = -1;
     int lastMatrix   = -1;
+    int lastCopy     = -1;
     int lastChunk    = -1;
 
     int statsGeometry = 0;
@@ -225,6 +227,23 @@ void RendererGL::draw(const FrameConfig& global)
         statsMatrix++;
       }
 
+      if(lastCopy != di.copyIndex)
+      {
+        if(bindless)
+        {
+          glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_COPY,
+                                 res->m_scene.m_buffers.copies.bufferADDR + res->m_alignedCopySize * di.copyIndex,
+                                 sizeof(CadScene::CopyNode));
+        }
+        else
+        {
+          glBindBufferRange(GL_UNIFORM_BUFFER, UBO_COPY, res->m_scene.m_buffers.copies.buffer,
+                            res->m_alignedCopySize * di.copyIndex, sizeof(CadScene::CopyNode));
+        }
+
+        lastCopy = di.copyIndex;
+      }
+
       glDrawElementsBaseVertex(GL_TRIANGLES, di.range.count, di.shorts ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
                                (void*)(di.range.offset + geo.ibo.offset), geo.vbo.offset / res->m_vertexSize);
 
@@ -239,6 +258,7 @@ void RendererGL::draw(const FrameConfig& global)
 
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_SCENE_VIEW, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_OBJECT, 0);
+  glBindBufferBase(GL_UNIFORM_BUFFER, UBO_COPY, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_GEOMETRY, 0);
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -145,6 +145,7 @@ void RendererMeshGL::draw(const FrameConfig& global)
 
     glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_SCENE_VIEW, 0, 0);
     glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_OBJECT, 0, 0);
+    glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_COPY, 0, 0);
     glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_GEOMETRY, 0, 0);
   }
 
@@ -161,6 +162,7 @@ void RendererMeshGL::draw(const FrameConfig& global)
     int lastMaterial = -1;
     int lastGeometry = -1;
     int lastMatrix   = -1;
+    int lastCopy     = -1;
     int lastChunk    = -1;
 
     bool lastTask   = false;
@@ -238,7 +240,24 @@ void RendererMeshGL::draw(const FrameConfig& global)
         statsMatrix++;
       }
 
-      glUniform4ui(1, di.meshlet.offset, di.meshlet.offset + di.meshlet.count - 1, 0, 0);
+      if(lastCopy != di.copyIndex)
+      {
+        if(bindless)
+        {
+          glBufferAddressRangeNV(GL_UNIFORM_BUFFER_ADDRESS_NV, UBO_COPY,
+                                 res->m_scene.m_buffers.copies.bufferADDR + res->m_alignedCopySize * di.copyIndex,
+                                 sizeof(CadScene::CopyNode));
+        }
+        else
+        {
+          glBindBufferRange(GL_UNIFORM_BUFFER, UBO_COPY, res->m_scene.m_buffers.copies.buffer,
+                            res->m_alignedCopySize * di.copyIndex, sizeof(CadScene::CopyNode));
+        }
+
+        lastCopy = di.copyIndex;
+      }
+
+      glUniform4ui(1, di.meshlet.offset, di.meshlet.offset + di.meshlet.count - 1, di.partFirst, di.partLast);
       uint32_t count = useTask ?
                            ((di.meshlet.count + m_list->m_config.taskNumMeshlets - 1) / m_list->m_config.taskNumMeshlets) :
                            ((di.meshlet.count + m_list->m_config.meshNumMeshlets - 1) / m_list->m_config.meshNumMeshlets);
@@ -255,6 +274,7 @@ void RendererMeshGL::draw(const FrameConfig& global)
   glBindBufferBase(GL_SHADER_STORAGE_BUFFER, SSBO_SCENE_STATS, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_SCENE_VIEW, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_OBJECT, 0);
+  glBindBufferBase(GL_UNIFORM_BUFFER, UBO_COPY, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_GEOMETRY, 0);
 
   res->copyStats();
@@ -85,6 +85,7 @@ private:
     int lastMaterial = -1;
     int lastGeometry = -1;
     int lastMatrix   = -1;
+    int lastCopy     = -1;
     int lastChunk    = -1;
 
     bool first = true;
@@ -113,12 +114,13 @@ private:
         lastGeometry = di.geometryIndex;
       }
 
-      if(lastMatrix != di.matrixIndex)
+      if(lastMatrix != di.matrixIndex || lastCopy != di.copyIndex)
       {
-        uint32_t offset = di.matrixIndex * res->m_alignedMatrixSize;
+        uint32_t offsets[2] = {di.matrixIndex * res->m_alignedMatrixSize, di.copyIndex * res->m_alignedCopySize};
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, setup.container.getPipeLayout(), DSET_OBJECT, 1,
-                                setup.container.at(DSET_OBJECT).getSets(), 1, &offset);
+                                setup.container.at(DSET_OBJECT).getSets(), 2, offsets);
         lastMatrix = di.matrixIndex;
+        lastCopy   = di.copyIndex;
       }
 
       // drawcall
@@ -113,6 +113,7 @@ private:
     int lastMaterial = -1;
     int lastGeometry = -1;
     int lastMatrix   = -1;
+    int lastCopy     = -1;
     int lastChunk    = -1;
 
     bool lastTask = true;
@@ -169,20 +170,21 @@ private:
         lastGeometry = di.geometryIndex;
       }
 
-      if(lastMatrix != di.matrixIndex)
+      if(lastMatrix != di.matrixIndex || lastCopy != di.copyIndex)
       {
-        uint32_t offset = di.matrixIndex * res->m_alignedMatrixSize;
+        uint32_t offsets[2] = {di.matrixIndex * res->m_alignedMatrixSize, di.copyIndex * res->m_alignedCopySize};
         vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, setup.container.getPipeLayout(), DSET_OBJECT, 1,
-                                setup.container.at(DSET_OBJECT).getSets(), 1, &offset);
+                                setup.container.at(DSET_OBJECT).getSets(), 2, offsets);
         lastMatrix = di.matrixIndex;
+        lastCopy   = di.copyIndex;
       }
 
       {
         nvmath::uvec4 drawRange;
         drawRange.x = di.meshlet.offset;
         drawRange.y = di.meshlet.offset + di.meshlet.count - 1;
-        drawRange.z = 0;
-        drawRange.w = 0;
+        drawRange.z = di.partFirst;
+        drawRange.w = di.partLast;
         vkCmdPushConstants(cmd, setup.container.getPipeLayout(), VK_SHADER_STAGE_TASK_BIT_NV | VK_SHADER_STAGE_MESH_BIT_NV,
                            sizeof(uint32_t) * 4, sizeof(drawRange), &drawRange);
       }
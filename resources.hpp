@@ -69,6 +69,7 @@ public:
 
   uint32_t m_extraAttributes = 0;
   uint32_t m_alignedMatrixSize{};
+  uint32_t m_alignedCopySize{};
   uint32_t m_alignedMaterialSize{};
   uint32_t m_vertexSize{};
   uint32_t m_vertexAttributeSize{};
@@ -108,9 +109,11 @@ public:
     // FIXME could solve differently
 
     m_alignedMatrixSize   = (uint32_t)(alignedSize(sizeof(CadScene::MatrixNode), uboAlignment));
+    m_alignedCopySize     = (uint32_t)(alignedSize(sizeof(CadScene::CopyNode), uboAlignment));
     m_alignedMaterialSize = (uint32_t)(alignedSize(sizeof(CadScene::Material), uboAlignment));
 
     assert(sizeof(CadScene::MatrixNode) == m_alignedMatrixSize);
+    assert(sizeof(CadScene::CopyNode) == m_alignedCopySize);
     assert(sizeof(CadScene::Material) == m_alignedMaterialSize);
   }
 };
@@ -97,6 +97,7 @@ bool ResourcesGL::initScene(const CadScene& cadscene)
   m_scene.init(cadscene);
 
   assert(sizeof(CadScene::MatrixNode) == m_alignedMatrixSize);
+  assert(sizeof(CadScene::CopyNode) == m_alignedCopySize);
   assert(sizeof(CadScene::Material) == m_alignedMaterialSize);
 
   std::vector<CadSceneGL::GeometryUbo> geometryData(m_scene.m_geometryMem.getChunkCount());
@@ -272,6 +273,7 @@ void ResourcesGL::drawBoundingBoxes(const class RenderList* NV_RESTRICT list) co
     int  lastMaterial = -1;
     int  lastGeometry = -1;
     int  lastMatrix   = -1;
+    int  lastCopy     = -1;
     int  lastChunk    = -1;
 
     for(int i = 0; i < list->m_drawItems.size(); i++)
@@ -304,12 +306,21 @@ void ResourcesGL::drawBoundingBoxes(const class RenderList* NV_RESTRICT list) co
         lastMatrix = di.matrixIndex;
       }
 
+      if(lastCopy != di.copyIndex)
+      {
+        glBindBufferRange(GL_UNIFORM_BUFFER, UBO_COPY, m_scene.m_buffers.copies.buffer,
+                          m_alignedCopySize * di.copyIndex, sizeof(CadScene::CopyNode));
+
+        lastCopy = di.copyIndex;
+      }
+
       glDrawArrays(GL_POINTS, di.meshlet.offset, di.meshlet.count);
     }
   }
 
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_SCENE_VIEW, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_OBJECT, 0);
+  glBindBufferBase(GL_UNIFORM_BUFFER, UBO_COPY, 0);
   glBindBufferBase(GL_UNIFORM_BUFFER, UBO_GEOMETRY, 0);
 
   glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
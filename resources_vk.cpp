@@ -289,6 +289,9 @@ void ResourcesVK::initPipeLayouts()
     auto& bindingsObject = setup.container.at(DSET_OBJECT);
     bindingsObject.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr);
+    // UBO COPY, offset of the scene copy
+    bindingsObject.addBinding(1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
+                              VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr);
     bindingsObject.initLayout();
 
     setup.container.initPipeLayout(0, 2, uint32_t(0));
@@ -307,6 +310,9 @@ void ResourcesVK::initPipeLayouts()
     auto& bindingsObject = setup.container.at(DSET_OBJECT);
     bindingsObject.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
                               VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT, nullptr);
+    // UBO COPY, offset of the scene copy
+    bindingsObject.addBinding(1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
+                              VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_GEOMETRY_BIT, nullptr);
     bindingsObject.initLayout();
     // UBO GEOMETRY
     auto& bindingsGeometry = setup.container.at(DSET_GEOMETRY);
@@ -350,11 +356,15 @@ void ResourcesVK::initPipeLayouts()
     auto& bindingsObject = setup.container.at(DSET_OBJECT);
     bindingsObject.addBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
                               stageTask | stageMesh | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr);
+    // UBO COPY, offset of the scene copy
+    bindingsObject.addBinding(1, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,
+                              stageTask | stageMesh | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr);
     bindingsObject.initLayout();
     // UBO GEOMETRY
     auto& bindingsGeometry = setup.container.at(DSET_GEOMETRY);
     bindingsGeometry.addBinding(GEOMETRY_SSBO_MESHLETDESC, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageTask | stageMesh, nullptr);
-    bindingsGeometry.addBinding(GEOMETRY_SSBO_PRIM, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageMesh, nullptr);
+    // task stage reads the lod of the meshlets
+    bindingsGeometry.addBinding(GEOMETRY_SSBO_PRIM, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, stageTask | stageMesh, nullptr);
     bindingsGeometry.addBinding(GEOMETRY_TEX_VBO, VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1,
                                 stageMesh | VK_SHADER_STAGE_FRAGMENT_BIT, nullptr);
     bindingsGeometry.addBinding(GEOMETRY_TEX_ABO, VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, 1,
@@ -1392,8 +1402,10 @@ bool ResourcesVK::initScene(const CadScene& cadscene)
         VkWriteDescriptorSet updateDescriptors[] = {
             m_setupStandard.container.at(DSET_SCENE).makeWrite(0, SCENE_UBO_VIEW, &m_common.viewInfo),
             m_setupStandard.container.at(DSET_OBJECT).makeWrite(0, 0, &m_scene.m_infos.matricesSingle),
+            m_setupStandard.container.at(DSET_OBJECT).makeWrite(0, 1, &m_scene.m_infos.copiesSingle),
             m_setupBbox.container.at(DSET_SCENE).makeWrite(0, SCENE_UBO_VIEW, &m_common.viewInfo),
             m_setupBbox.container.at(DSET_OBJECT).makeWrite(0, 0, &m_scene.m_infos.matricesSingle),
+            m_setupBbox.container.at(DSET_OBJECT).makeWrite(0, 1, &m_scene.m_infos.copiesSingle),
 
         };
         vkUpdateDescriptorSets(m_device, NV_ARRAY_SIZE(updateDescriptors), updateDescriptors, 0, nullptr);
@@ -1409,6 +1421,7 @@ bool ResourcesVK::initScene(const CadScene& cadscene)
             setup.container.at(DSET_SCENE).makeWrite(0, SCENE_UBO_VIEW, &m_common.viewInfo),
             setup.container.at(DSET_SCENE).makeWrite(0, SCENE_SSBO_STATS, &m_common.statsInfo),
             setup.container.at(DSET_OBJECT).makeWrite(0, 0, &m_scene.m_infos.matricesSingle),
+            setup.container.at(DSET_OBJECT).makeWrite(0, 1, &m_scene.m_infos.copiesSingle),
         };
         vkUpdateDescriptorSets(m_device, NV_ARRAY_SIZE(updateDescriptors), updateDescriptors, 0, nullptr);
       }
@@ -1528,6 +1541,7 @@ VkCommandBuffer ResourcesVK::createBoundingBoxCmdBuffer(VkCommandPool pool, cons
 
   int lastGeometry = -1;
   int lastMatrix   = -1;
+  int lastCopy     = -1;
   int lastChunk    = -1;
 
   bool first = true;
@@ -1565,12 +1579,13 @@ VkCommandBuffer ResourcesVK::createBoundingBoxCmdBuffer(VkCommandPool pool, cons
       lastGeometry = di.geometryIndex;
     }
 
-    if(lastMatrix != di.matrixIndex)
+    if(lastMatrix != di.matrixIndex || lastCopy != di.copyIndex)
     {
-      uint32_t offset = di.matrixIndex * res->m_alignedMatrixSize;
+      uint32_t offsets[2] = {di.matrixIndex * res->m_alignedMatrixSize, di.copyIndex * res->m_alignedCopySize};
       vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, setup.container.getPipeLayout(), DSET_OBJECT, 1,
-                              setup.container.at(DSET_OBJECT).getSets(), 1, &offset);
+                              setup.container.at(DSET_OBJECT).getSets(), 2, offsets);
       lastMatrix = di.matrixIndex;
+      lastCopy   = di.copyIndex;
     }
 
     vkCmdDraw(cmd, di.meshlet.count, 1, di.meshlet.offset, 0);